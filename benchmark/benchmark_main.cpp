@@ -1,10 +1,13 @@
 #include <chfloat/chfloat.h>
 
+#include <charconv>
 #include <chrono>
+#include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
@@ -13,6 +16,7 @@
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 #if defined(_WIN32)
@@ -20,6 +24,21 @@
   #include <windows.h>
 #endif
 
+#if defined(__linux__)
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  #include <intrin.h>
+  #define CHFLOAT_BENCH_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+  #define CHFLOAT_BENCH_RDTSC 1
+#endif
+
 #include <fast_float/fast_float.h>
 
 namespace {
@@ -30,8 +49,13 @@ struct bench_result {
   std::string name;
   double seconds = 0.0;
   size_t items = 0;
+  size_t bytes = 0;
   double items_per_sec = 0.0;
   double mb_per_sec = 0.0;
+  // Hardware counter totals over the timed loop; negative when not measured.
+  double cycles = -1.0;
+  double instructions = -1.0;
+  double branch_misses = -1.0;
 };
 
 static double now_seconds() {
@@ -61,6 +85,163 @@ static void setup_benchmark_process() {
 #endif
 }
 
+// Optional hardware counters around each timed loop. On Linux a perf_event group counts user-space
+// cycles, instructions and branch misses; where that is unavailable (other OSes, containers,
+// perf_event_paranoid) x86 falls back to rdtsc for reference cycles only, and elsewhere nothing
+// is counted. Missing counters just leave their report columns out.
+class hw_counters {
+ public:
+  enum class source { none, perf_event, rdtsc };
+
+  void open() {
+#if defined(__linux__)
+    const std::uint64_t configs[3] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                      PERF_COUNT_HW_BRANCH_MISSES};
+    for (int i = 0; i < 3; ++i) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = configs[i];
+      attr.disabled = (i == 0) ? 1 : 0;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP;
+      fds_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, (i == 0) ? -1 : fds_[0], 0));
+      if (fds_[i] < 0) {
+        close();
+        break;
+      }
+    }
+    if (fds_[0] >= 0) {
+      src_ = source::perf_event;
+      return;
+    }
+#endif
+#if defined(CHFLOAT_BENCH_RDTSC)
+    src_ = source::rdtsc;
+#endif
+  }
+
+  ~hw_counters() { close(); }
+
+  source kind() const { return src_; }
+
+  const char* description() const {
+    switch (src_) {
+      case source::perf_event:
+        return "perf_event (user-space cycles, instructions, branch-misses)";
+      case source::rdtsc:
+        return "rdtsc (reference cycles only; perf_event unavailable)";
+      default:
+        return "none";
+    }
+  }
+
+  void start() {
+#if defined(__linux__)
+    if (src_ == source::perf_event) {
+      ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+      return;
+    }
+#endif
+#if defined(CHFLOAT_BENCH_RDTSC)
+    if (src_ == source::rdtsc) tsc_start_ = __rdtsc();
+#endif
+  }
+
+  // Stores the counts since start() into r (cycles only for rdtsc).
+  void stop(bench_result& r) {
+#if defined(__linux__)
+    if (src_ == source::perf_event) {
+      ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+      std::uint64_t buf[4] = {0, 0, 0, 0}; // nr, then one value per event
+      if (read(fds_[0], buf, sizeof(buf)) == static_cast<ssize_t>(sizeof(buf)) && buf[0] == 3) {
+        r.cycles = static_cast<double>(buf[1]);
+        r.instructions = static_cast<double>(buf[2]);
+        r.branch_misses = static_cast<double>(buf[3]);
+      }
+      return;
+    }
+#endif
+#if defined(CHFLOAT_BENCH_RDTSC)
+    if (src_ == source::rdtsc) r.cycles = static_cast<double>(__rdtsc() - tsc_start_);
+#endif
+    (void)r;
+  }
+
+ private:
+  void close() {
+#if defined(__linux__)
+    for (int& fd : fds_) {
+      if (fd >= 0) ::close(fd);
+      fd = -1;
+    }
+#endif
+  }
+
+  source src_ = source::none;
+  int fds_[3] = {-1, -1, -1};
+  unsigned long long tsc_start_ = 0;
+};
+
+static hw_counters g_counters;
+
+// Per-call latency clock: rdtsc on x86 (lfence-ordered, converted with a rate calibrated against
+// steady_clock), steady_clock elsewhere. overhead_ticks is the median cost of an empty
+// measurement and is subtracted from every sample.
+class tick_clock {
+ public:
+  tick_clock() {
+#if defined(CHFLOAT_BENCH_RDTSC)
+    const double t0 = now_seconds();
+    const std::uint64_t c0 = now();
+    while (now_seconds() - t0 < 0.02) {
+    }
+    const std::uint64_t c1 = now();
+    const double t1 = now_seconds();
+    ns_per_tick_ = (t1 - t0) * 1e9 / static_cast<double>(c1 - c0);
+#endif
+    std::vector<std::uint64_t> empty(1001);
+    for (auto& e : empty) {
+      const std::uint64_t a = now();
+      std::atomic_signal_fence(std::memory_order_seq_cst);
+      e = now() - a;
+    }
+    std::nth_element(empty.begin(), empty.begin() + 500, empty.end());
+    overhead_ticks_ = empty[500];
+  }
+
+  static std::uint64_t now() {
+#if defined(CHFLOAT_BENCH_RDTSC)
+    _mm_lfence();
+    const std::uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+#else
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count());
+#endif
+  }
+
+  double ns(std::uint64_t ticks) const {
+    return static_cast<double>(ticks > overhead_ticks_ ? ticks - overhead_ticks_ : 0) * ns_per_tick_;
+  }
+
+  const char* description() const {
+#if defined(CHFLOAT_BENCH_RDTSC)
+    return "rdtsc";
+#else
+    return "steady_clock";
+#endif
+  }
+
+ private:
+  double ns_per_tick_ = 1.0;
+  std::uint64_t overhead_ticks_ = 0;
+};
+
 static std::vector<std::string> make_random_decimal_strings(size_t n, uint32_t seed) {
   std::mt19937 rng(seed);
   std::uniform_int_distribution<int> sign_dist(0, 1);
@@ -153,14 +334,215 @@ static std::vector<std::string> make_random_decimal_strings_ex(size_t n, uint32_
   return out;
 }
 
+// Corpora shaped like common real-world number files, generated deterministically so runs stay
+// comparable without shipping data files:
+//   canada_coords   - GeoJSON polygon coordinates as in canada.json: longitude/latitude random
+//                     walks printed as shortest round-trip doubles (mostly 15-17 digits)
+//   mesh            - 3D mesh vertex data: float-precision coordinates printed with %g (at most 6
+//                     digits), with many repeated 0.0 / 1 / -1 values
+//   financial_ticks - market data: price random walks with 2 decimals, FX quotes with 5, and
+//                     integer trade sizes
+//   round_trip_17   - %.17g of random doubles over a handful of repeating exponents
+static std::string shortest(double v) {
+  char buf[32];
+  auto r = chfloat::to_chars(buf, buf + sizeof(buf), v);
+  return std::string(buf, r.ptr);
+}
+
+static std::string printf_string(const char* fmt, double v) {
+  char buf[64];
+  const int len = std::snprintf(buf, sizeof(buf), fmt, v);
+  return std::string(buf, static_cast<size_t>(len));
+}
+
+static std::vector<std::string> make_canada_coords(size_t n, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> step(-1000, 1000);
+  std::vector<std::string> out;
+  out.reserve(n);
+  double lon = -65.613616999999977;
+  double lat = 43.420273000000009;
+  for (size_t i = 0; i < n; ++i) {
+    if ((i & 1) == 0) {
+      lon += step(rng) * 1e-6;
+      out.push_back(shortest(lon));
+    } else {
+      lat += step(rng) * 1e-6;
+      out.push_back(shortest(lat));
+    }
+  }
+  return out;
+}
+
+static std::vector<std::string> make_mesh(size_t n, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> kind(0, 99);
+  std::uniform_real_distribution<float> coord(-50.0f, 50.0f);
+  std::vector<std::string> out;
+  out.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    const int k = kind(rng);
+    if (k < 15) {
+      out.push_back("0.0");
+    } else if (k < 20) {
+      out.push_back((k & 1) ? "1" : "-1");
+    } else {
+      out.push_back(printf_string("%g", static_cast<double>(coord(rng))));
+    }
+  }
+  return out;
+}
+
+static std::vector<std::string> make_financial_ticks(size_t n, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> kind(0, 99);
+  std::uniform_int_distribution<int> tick(-3, 3);
+  std::uniform_int_distribution<int> lots(1, 100);
+  std::vector<std::string> out;
+  out.reserve(n);
+  long long price_cents = 10000; // 100.00
+  long long fx_pips = 108230;    // 1.08230
+  for (size_t i = 0; i < n; ++i) {
+    const int k = kind(rng);
+    if (k < 60) {
+      price_cents = std::max(100LL, price_cents + tick(rng));
+      out.push_back(printf_string("%.2f", static_cast<double>(price_cents) / 100.0));
+    } else if (k < 85) {
+      fx_pips = std::max(1000LL, fx_pips + tick(rng));
+      out.push_back(printf_string("%.5f", static_cast<double>(fx_pips) / 100000.0));
+    } else {
+      out.push_back(std::to_string(lots(rng) * 100));
+    }
+  }
+  return out;
+}
+
+static std::vector<std::string> make_round_trip_17(size_t n, uint32_t seed) {
+  std::mt19937_64 rng(seed);
+  std::uniform_real_distribution<double> mant(1.0, 10.0);
+  const double scales[] = {1e-3, 1e-1, 1.0, 1e2, 1e5};
+  std::vector<std::string> out;
+  out.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    const double v = mant(rng) * scales[rng() % std::size(scales)];
+    out.push_back(printf_string((rng() & 1) ? "%.17g" : "-%.17g", v));
+  }
+  return out;
+}
+
+// --file input: one number per line (CR before LF and blank lines are ignored).
+static bool read_number_lines(const std::string& path, std::vector<std::string>& out) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) return false;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (!line.empty()) out.push_back(line);
+  }
+  return !in.bad();
+}
+
 static size_t total_bytes(const std::vector<std::string>& v) {
   size_t b = 0;
   for (auto& s : v) b += s.size();
   return b;
 }
 
-template <class Fn>
-static bench_result run_bench(const std::string& name, const std::vector<std::string>& inputs, Fn&& fn, size_t iters) {
+// from_chars_padded inputs: tokens in one arena, each followed by from_chars_padding bytes.
+struct padded_token {
+  const char* first;
+  const char* last;
+};
+
+static std::vector<padded_token> make_padded_tokens(const std::vector<std::string>& v, std::string& arena) {
+  arena.clear();
+  for (auto& s : v) {
+    arena += s;
+    arena.append(chfloat::from_chars_padding, '\0');
+  }
+  std::vector<padded_token> out;
+  out.reserve(v.size());
+  const char* p = arena.data();
+  for (auto& s : v) {
+    out.push_back({p, p + s.size()});
+    p += s.size() + chfloat::from_chars_padding;
+  }
+  return out;
+}
+
+static size_t total_bytes(const std::vector<padded_token>& v) {
+  size_t b = 0;
+  for (auto& t : v) b += static_cast<size_t>(t.last - t.first);
+  return b;
+}
+
+// Contiguous inputs: all numbers in one newline-separated buffer, parsed front to back the
+// way a file or network buffer is consumed. The buffer is followed by from_chars_padding NUL
+// bytes (not counted) so from_chars_padded can run over it too.
+struct number_arena {
+  std::string buf;
+  size_t size = 0;  // bytes of text, excluding the padding
+  size_t count = 0; // numbers in the text
+  const char* first() const { return buf.data(); }
+  const char* last() const { return buf.data() + size; }
+};
+
+static number_arena make_arena(const std::vector<std::string>& v) {
+  number_arena a;
+  for (auto& s : v) {
+    a.buf += s;
+    a.buf += '\n';
+  }
+  a.size = a.buf.size();
+  a.count = v.size();
+  a.buf.append(chfloat::from_chars_padding, '\0');
+  return a;
+}
+
+// from_chars_many over a whole arena. An out-of-range token (a float underflow, say) ends a
+// call, so parsing resumes past it, as the per-call loops do.
+template <class T>
+static double parse_arena_many(const number_arena& a, std::vector<T>& out) {
+  const char* p = a.first();
+  size_t n = 0;
+  while (p < a.last() && n < out.size()) {
+    const auto r = chfloat::from_chars_many(p, a.last(), '\n', out.data() + n, out.size() - n);
+    n += r.count;
+    if (r.ec == chfloat::errc::ok) break;
+    p = static_cast<const char*>(std::memchr(r.ptr, '\n', static_cast<size_t>(a.last() - r.ptr)));
+    if (p == nullptr) break;
+    ++p;
+    out[n++] = T(0);
+  }
+  return (n != 0) ? static_cast<double>(out[0]) + static_cast<double>(n) : 0.0;
+}
+
+static size_t total_bytes(const std::vector<number_arena>& v) {
+  size_t b = 0;
+  for (auto& a : v) b += a.size;
+  return b;
+}
+
+// Formatting inputs: binary values, counted by their in-memory size.
+template <class T>
+static size_t total_bytes(const std::vector<T>& v) {
+  return v.size() * sizeof(T);
+}
+
+// Items per pass over the inputs: one per element, except an arena holds many numbers.
+template <class Input>
+static size_t total_items(const std::vector<Input>& v) {
+  return v.size();
+}
+
+static size_t total_items(const std::vector<number_arena>& v) {
+  size_t n = 0;
+  for (auto& a : v) n += a.count;
+  return n;
+}
+
+template <class Input, class Fn>
+static bench_result run_bench(const std::string& name, const std::vector<Input>& inputs, Fn&& fn, size_t iters) {
   // Warmup
   {
     double sink = 0;
@@ -170,6 +552,8 @@ static bench_result run_bench(const std::string& name, const std::vector<std::st
     if (sink == 1234567.0) std::cerr << "";
   }
 
+  bench_result r;
+  g_counters.start();
   double start = now_seconds();
   double sink = 0;
   for (size_t it = 0; it < iters; ++it) {
@@ -178,17 +562,18 @@ static bench_result run_bench(const std::string& name, const std::vector<std::st
     }
   }
   double end = now_seconds();
+  g_counters.stop(r);
   if (sink == 1234567.0) std::cerr << "";
 
   const double sec = end - start;
-  const size_t items = inputs.size() * iters;
+  const size_t items = total_items(inputs) * iters;
   const double ips = (sec > 0) ? (static_cast<double>(items) / sec) : 0.0;
   const double mbps = (sec > 0) ? (static_cast<double>(total_bytes(inputs) * iters) / (1024.0 * 1024.0) / sec) : 0.0;
 
-  bench_result r;
   r.name = name;
   r.seconds = sec;
   r.items = items;
+  r.bytes = total_bytes(inputs) * iters;
   r.items_per_sec = ips;
   r.mb_per_sec = mbps;
   return r;
@@ -219,17 +604,20 @@ static double median_inplace(std::vector<double>& v) {
   return m;
 }
 
-template <class Fn>
-static bench_result run_bench_stable(const std::string& name, const std::vector<std::string>& inputs, Fn&& fn,
+template <class Input, class Fn>
+static bench_result run_bench_stable(const std::string& name, const std::vector<Input>& inputs, Fn&& fn,
                                      size_t iters, size_t runs) {
-  std::vector<double> seconds;
+  std::vector<double> seconds, cycles, instructions, branch_misses;
   seconds.reserve(runs);
   for (size_t i = 0; i < runs; ++i) {
     auto r = run_bench(name, inputs, fn, iters);
     seconds.push_back(r.seconds);
+    if (r.cycles >= 0) cycles.push_back(r.cycles);
+    if (r.instructions >= 0) instructions.push_back(r.instructions);
+    if (r.branch_misses >= 0) branch_misses.push_back(r.branch_misses);
   }
   const double med_sec = median_inplace(seconds);
-  const size_t items = inputs.size() * iters;
+  const size_t items = total_items(inputs) * iters;
   const double ips = (med_sec > 0) ? (static_cast<double>(items) / med_sec) : 0.0;
   const double mbps = (med_sec > 0) ? (static_cast<double>(total_bytes(inputs) * iters) / (1024.0 * 1024.0) / med_sec)
                                     : 0.0;
@@ -238,45 +626,206 @@ static bench_result run_bench_stable(const std::string& name, const std::vector<
   out.name = name;
   out.seconds = med_sec;
   out.items = items;
+  out.bytes = total_bytes(inputs) * iters;
   out.items_per_sec = ips;
   out.mb_per_sec = mbps;
+  // Counters: per-counter medians across the runs.
+  if (cycles.size() == runs) out.cycles = median_inplace(cycles);
+  if (instructions.size() == runs) out.instructions = median_inplace(instructions);
+  if (branch_misses.size() == runs) out.branch_misses = median_inplace(branch_misses);
   return out;
 }
 
+// Renders cells[0] as the header row of a markdown table, padding every column to its widest cell.
+static void write_table(std::ofstream& out, const std::vector<std::vector<std::string>>& cells) {
+  std::vector<size_t> widths(cells[0].size(), 0);
+  for (auto& c : cells) {
+    for (size_t i = 0; i < c.size(); ++i) widths[i] = std::max(widths[i], c[i].size());
+  }
+
+  auto line = [&](const std::vector<std::string>& c) {
+    out << "|";
+    for (size_t i = 0; i < c.size(); ++i) out << " " << pad_right(c[i], widths[i]) << " |";
+    out << "\n";
+  };
+
+  line(cells[0]);
+  std::vector<std::string> rule;
+  for (size_t w : widths) rule.push_back(std::string(w, '-'));
+  line(rule);
+  for (size_t i = 1; i < cells.size(); ++i) line(cells[i]);
+}
+
 static void write_markdown_table(std::ofstream& out, const std::vector<bench_result>& rows) {
-  // Determine column widths
-  size_t w_name = std::strlen("Name");
-  size_t w_sec = std::strlen("Seconds");
-  size_t w_ips = std::strlen("Items/s");
-  size_t w_mbps = std::strlen("MB/s");
+  // Counter columns appear only when some row measured them.
+  bool has_cycles = false, has_instructions = false, has_branch_misses = false;
+  for (auto& r : rows) {
+    has_cycles |= (r.cycles >= 0);
+    has_instructions |= (r.instructions >= 0);
+    has_branch_misses |= (r.branch_misses >= 0);
+  }
+  auto per = [](double total, size_t n, int precision) {
+    return (total >= 0 && n != 0) ? fmt_double(total / static_cast<double>(n), precision) : std::string("n/a");
+  };
 
-  std::vector<std::array<std::string, 4>> cells;
-  cells.reserve(rows.size());
+  std::vector<std::vector<std::string>> cells;
+  cells.reserve(rows.size() + 1);
+  std::vector<std::string> header = {"Name", "Seconds", "Items/s", "MB/s", "GB/s"};
+  if (has_cycles) {
+    header.push_back("Cycles/item");
+    header.push_back("Cycles/B");
+  }
+  if (has_instructions) {
+    header.push_back("Instr/item");
+    if (has_cycles) header.push_back("IPC");
+  }
+  if (has_branch_misses) header.push_back("Br-miss/item");
+  cells.push_back(header);
 
   for (auto& r : rows) {
-    std::array<std::string, 4> c = {
+    std::vector<std::string> c = {
         r.name,
         fmt_double(r.seconds, 6),
         fmt_double(r.items_per_sec, 0),
         fmt_double(r.mb_per_sec, 2),
+        fmt_double(r.mb_per_sec / 1024.0, 3),
     };
-    w_name = std::max(w_name, c[0].size());
-    w_sec = std::max(w_sec, c[1].size());
-    w_ips = std::max(w_ips, c[2].size());
-    w_mbps = std::max(w_mbps, c[3].size());
+    if (has_cycles) {
+      c.push_back(per(r.cycles, r.items, 1));
+      c.push_back(per(r.cycles, r.bytes, 2));
+    }
+    if (has_instructions) {
+      c.push_back(per(r.instructions, r.items, 1));
+      if (has_cycles) {
+        c.push_back((r.instructions >= 0 && r.cycles > 0) ? fmt_double(r.instructions / r.cycles, 2)
+                                                          : std::string("n/a"));
+      }
+    }
+    if (has_branch_misses) c.push_back(per(r.branch_misses, r.items, 3));
     cells.push_back(std::move(c));
   }
+  write_table(out, cells);
+}
 
-  auto line = [&](const std::string& a, const std::string& b, const std::string& c, const std::string& d) {
-    out << "| " << pad_right(a, w_name) << " | " << pad_right(b, w_sec) << " | " << pad_right(c, w_ips)
-        << " | " << pad_right(d, w_mbps) << " |\n";
-  };
+// Per-call latency percentiles, in nanoseconds.
+struct latency_result {
+  std::string name;
+  size_t samples = 0;
+  double p50 = 0.0;
+  double p90 = 0.0;
+  double p99 = 0.0;
+  double p999 = 0.0;
+  double max = 0.0;
+};
 
-  line("Name", "Seconds", "Items/s", "MB/s");
-  line(std::string(w_name, '-'), std::string(w_sec, '-'), std::string(w_ips, '-'), std::string(w_mbps, '-'));
-  for (auto& c : cells) {
-    line(c[0], c[1], c[2], c[3]);
+// Times every call separately (iters passes over the inputs after one warmup pass). The fences
+// keep the compiler from moving the call's loads or its result out of the timed window.
+template <class Input, class Fn>
+static latency_result run_latency(const tick_clock& clock, const std::string& name, const std::vector<Input>& inputs,
+                                  Fn&& fn, size_t iters) {
+  double sink = 0;
+  for (size_t i = 0; i < inputs.size(); ++i) sink += fn(inputs[i]);
+
+  std::vector<std::uint64_t> ticks;
+  ticks.reserve(inputs.size() * iters);
+  for (size_t it = 0; it < iters; ++it) {
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      const std::uint64_t t0 = tick_clock::now();
+      std::atomic_signal_fence(std::memory_order_seq_cst);
+      sink += fn(inputs[i]);
+      std::atomic_signal_fence(std::memory_order_seq_cst);
+      ticks.push_back(tick_clock::now() - t0);
+    }
+  }
+  if (sink == 1234567.0) std::cerr << "";
+
+  latency_result r;
+  r.name = name;
+  r.samples = ticks.size();
+  if (ticks.empty()) return r;
+  std::sort(ticks.begin(), ticks.end());
+  auto at = [&](double q) { return clock.ns(ticks[static_cast<size_t>(q * static_cast<double>(ticks.size() - 1))]); };
+  r.p50 = at(0.50);
+  r.p90 = at(0.90);
+  r.p99 = at(0.99);
+  r.p999 = at(0.999);
+  r.max = clock.ns(ticks.back());
+  return r;
+}
+
+static void write_latency_table(std::ofstream& out, const std::vector<latency_result>& rows) {
+  std::vector<std::vector<std::string>> cells;
+  cells.push_back({"Name", "p50 ns", "p90 ns", "p99 ns", "p99.9 ns", "max ns"});
+  for (auto& r : rows) {
+    cells.push_back({r.name, fmt_double(r.p50, 1), fmt_double(r.p90, 1), fmt_double(r.p99, 1), fmt_double(r.p999, 1),
+                     fmt_double(r.max, 1)});
+  }
+  write_table(out, cells);
+}
+
+// Multi-threaded throughput: every thread parses its own copy of the inputs (allocated by that
+// thread, so it is local to its core/node), all start together after a warmup pass.
+struct scaling_result {
+  std::string name;
+  size_t threads = 0;
+  double seconds = 0.0;       // wall time, start signal to last thread done
+  double items_per_sec = 0.0; // aggregate
+  double mb_per_sec = 0.0;    // aggregate
+};
+
+template <class Fn>
+static scaling_result run_scaling(const std::string& name, const std::vector<std::string>& inputs, Fn fn,
+                                  size_t iters, size_t threads) {
+  std::atomic<size_t> ready{0};
+  std::atomic<bool> go{false};
+  std::vector<std::thread> pool;
+  pool.reserve(threads);
+  for (size_t t = 0; t < threads; ++t) {
+    pool.emplace_back([&] {
+      const std::vector<std::string> shard(inputs);
+      double sink = 0;
+      for (const std::string& s : shard) sink += fn(s);
+      ready.fetch_add(1);
+      while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+      for (size_t it = 0; it < iters; ++it) {
+        for (const std::string& s : shard) sink += fn(s);
+      }
+      if (sink == 1234567.0) std::cerr << "";
+    });
+  }
+  while (ready.load() != threads) std::this_thread::yield();
+  // Wall time from the start signal until the last thread is done.
+  const double start = now_seconds();
+  go.store(true, std::memory_order_release);
+  for (auto& th : pool) th.join();
+  const double wall = now_seconds() - start;
+
+  scaling_result r;
+  r.name = name;
+  r.threads = threads;
+  r.seconds = wall;
+  const double items = static_cast<double>(inputs.size() * iters * threads);
+  const double bytes = static_cast<double>(total_bytes(inputs) * iters * threads);
+  r.items_per_sec = (r.seconds > 0) ? items / r.seconds : 0.0;
+  r.mb_per_sec = (r.seconds > 0) ? bytes / (1024.0 * 1024.0) / r.seconds : 0.0;
+  return r;
+}
+
+static void write_scaling_table(std::ofstream& out, const std::vector<scaling_result>& rows) {
+  std::vector<std::vector<std::string>> cells;
+  cells.push_back({"Name", "Threads", "Items/s", "Items/s/thread", "MB/s", "Speedup", "Efficiency"});
+  for (auto& r : rows) {
+    // Baseline: the single-thread row of the same parser.
+    double base = 0.0;
+    for (auto& b : rows) {
+      if (b.name == r.name && b.threads == 1) base = b.items_per_sec;
+    }
+    const double per_thread = r.items_per_sec / static_cast<double>(r.threads);
+    cells.push_back({r.name, std::to_string(r.threads), fmt_double(r.items_per_sec, 0), fmt_double(per_thread, 0),
+                     fmt_double(r.mb_per_sec, 2), (base > 0) ? fmt_double(r.items_per_sec / base, 2) + "x" : "n/a",
+                     (base > 0) ? fmt_double(100.0 * per_thread / base, 1) + "%" : "n/a"});
   }
+  write_table(out, cells);
 }
 
 struct scenario_report {
@@ -285,10 +834,12 @@ struct scenario_report {
   size_t iters = 0;
   std::vector<bench_result> one_shot;
   std::vector<bench_result> stable;
+  std::vector<latency_result> latency; // per-call parsers only
+  std::vector<scaling_result> scaling; // --threads only
 };
 
 static void write_markdown_report(const std::string& path, const std::vector<scenario_report>& scenarios,
-                                  size_t stable_runs) {
+                                  size_t stable_runs, const tick_clock& clock) {
   std::filesystem::path p(path);
   if (p.has_parent_path()) {
     std::error_code ec;
@@ -316,6 +867,28 @@ static void write_markdown_report(const std::string& path, const std::vector<sce
 #else
   out << "- Compiler: (unknown)\n";
 #endif
+  out << "- Power-of-five table: "
+#if defined(CHFLOAT_COMPACT_POW5)
+         "compact"
+#else
+         "full"
+#endif
+      << " (" << chfloat::detail::pow5_table_bytes << " bytes)\n";
+  out << "- Kernels: "
+#if CHFLOAT_DISPATCH_X86
+      << "runtime dispatch, " << (chfloat::detail::host_cpu.avx2_bmi2 ? "AVX2/BMI2" : "portable") << " selected"
+#elif CHFLOAT_SIMD_AVX2
+      << "compile-time AVX2"
+#elif CHFLOAT_SIMD_SSE2
+      << "compile-time SSE2"
+#elif CHFLOAT_SIMD_NEON
+      << "compile-time NEON"
+#else
+      << "portable"
+#endif
+      << "\n";
+  out << "- Counters: " << g_counters.description() << "\n";
+  out << "- Latency clock: " << clock.description() << "\n";
   out << "- Baselines: chfloat + std::strtod/strtof\n";
   out << "- Comparison: fast_float\n";
   out << "\n";
@@ -331,12 +904,38 @@ static void write_markdown_report(const std::string& path, const std::vector<sce
     out << "- Runs: " << stable_runs << " (median seconds)\n\n";
     write_markdown_table(out, sc.stable);
     out << "\n\n";
+
+    if (!sc.latency.empty()) {
+      out << "### Latency (per call)\n\n";
+      out << "- Samples: " << sc.latency[0].samples << " per row\n\n";
+      write_latency_table(out, sc.latency);
+      out << "\n\n";
+    }
+
+    if (!sc.scaling.empty()) {
+      out << "### Thread scaling\n\n";
+      out << "- Each thread parses its own copy of the inputs, iters=" << sc.iters << "\n\n";
+      write_scaling_table(out, sc.scaling);
+      out << "\n\n";
+    }
   }
 
   out << "\nNotes:\n\n";
-  out << "- Items/s counts parsed numbers; MB/s counts input bytes processed.\n";
-  out << "- This benchmark is single-threaded and measures throughput on this machine.\n";
+  out << "- Items/s counts parsed numbers; MB/s and GB/s count input bytes processed (MiB/GiB).\n";
+  out << "- *_arena scenarios parse the same inputs laid out in one newline-separated buffer, front to back;\n"
+         "  the other parse scenarios hand each input over as its own std::string.\n";
+  out << "- to_chars scenarios format binary values: Items/s counts formatted numbers, MB/s counts 8 (double) or 4\n"
+         "  (float) input bytes per value.\n";
+  out << "- Apart from the 'Thread scaling' tables (--threads), this benchmark is single-threaded and measures\n"
+         "  throughput on this machine. Scaling Speedup/Efficiency compare against the 1-thread row; losses point\n"
+         "  at shared-cache, memory-bandwidth or frequency limits (the lookup tables are read-only and shared).\n";
   out << "- The 'Stable' table reports median seconds across multiple runs.\n";
+  out << "- Latency tables time each call on its own (timer overhead subtracted); percentiles show the tail that\n"
+         "  the throughput tables average away. Individual samples include interrupts and page faults.\n";
+  if (g_counters.kind() != hw_counters::source::none) {
+    out << "- Counter columns are per parsed number (Cycles/B per input byte) over the timed loop; the 'Stable'\n"
+           "  table uses per-counter medians. rdtsc counts reference cycles at the TSC rate, not core cycles.\n";
+  }
 }
 
 } // namespace
@@ -348,6 +947,10 @@ int main(int argc, char** argv) {
   size_t iters = 10;        // repeat count
   uint32_t seed = 12345;
   size_t stable_runs = 7;
+  bool counters = true;
+  size_t max_threads = 0; // --threads: 0 skips the scaling runs
+  std::vector<std::string> files;
+  std::vector<std::string> only; // --scenario filters; empty runs everything
 
   for (int i = 1; i < argc; ++i) {
     if (std::strcmp(argv[i], "--n") == 0 && i + 1 < argc) {
@@ -358,8 +961,33 @@ int main(int argc, char** argv) {
       seed = static_cast<uint32_t>(std::stoul(argv[++i]));
     } else if (std::strcmp(argv[i], "--stable-runs") == 0 && i + 1 < argc) {
       stable_runs = static_cast<size_t>(std::stoull(argv[++i]));
+    } else if (std::strcmp(argv[i], "--no-counters") == 0) {
+      counters = false;
+    } else if (std::strcmp(argv[i], "--file") == 0 && i + 1 < argc) {
+      files.push_back(argv[++i]);
+    } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      max_threads = static_cast<size_t>(std::stoull(argv[++i]));
+    } else if (std::strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) {
+      only.push_back(argv[++i]);
     }
   }
+  // A --file scenario is named "file:<file name>"; *_arena reports follow their base scenario.
+  auto wanted = [&only](const std::string& name) {
+    return only.empty() || std::find(only.begin(), only.end(), name) != only.end();
+  };
+
+  // Read --file inputs up front so a bad path fails before any benchmark runs.
+  std::vector<std::pair<std::string, std::vector<std::string>>> file_inputs;
+  for (const std::string& path : files) {
+    std::vector<std::string> inputs;
+    if (!read_number_lines(path, inputs) || inputs.empty()) {
+      std::cerr << "error: cannot read numbers from " << path << "\n";
+      return 1;
+    }
+    file_inputs.emplace_back("file:" + std::filesystem::path(path).filename().string(), std::move(inputs));
+  }
+  if (counters) g_counters.open();
+  const tick_clock clock;
 
   struct scenario_def {
     const char* name;
@@ -368,27 +996,71 @@ int main(int argc, char** argv) {
     int exp_min, exp_max;
     bool force_exp;
     uint32_t seed_salt;
+    // Format the inputs also satisfy; non-general formats get an extra row for the specialized path.
+    chfloat::chars_format fmt;
+    const char* fmt_name;
   };
 
   // Keep exponent within [-30, 30] so float and double both stay mostly in-range.
   const scenario_def defs[] = {
-      {"mixed", 1, 8, 0, 8, -30, 30, false, 0x11111111u},
-      {"short_no_exp", 1, 6, 0, 2, 0, 0, false, 0x22222222u},
-      {"long_frac", 1, 16, 0, 16, -30, 30, true, 0x33333333u},
+      {"mixed", 1, 8, 0, 8, -30, 30, false, 0x11111111u, chfloat::chars_format::general, "general"},
+      {"short_no_exp", 1, 6, 0, 2, 0, 0, false, 0x22222222u, chfloat::chars_format::fixed, "fixed"},
+      {"long_frac", 1, 16, 0, 16, -30, 30, true, 0x33333333u, chfloat::chars_format::scientific, "scientific"},
   };
 
+  struct corpus_def {
+    const char* name;
+    std::vector<std::string> (*make)(size_t, uint32_t);
+    uint32_t seed_salt;
+  };
+  const corpus_def corpora[] = {
+      {"canada_coords", make_canada_coords, 0x55555555u},
+      {"mesh", make_mesh, 0x66666666u},
+      {"financial_ticks", make_financial_ticks, 0x77777777u},
+      {"round_trip_17", make_round_trip_17, 0x88888888u},
+  };
+
+  // Formatting: shortest round-trip text for values with short decimal forms (parsed from the
+  // "mixed" inputs) and for uniformly random bit patterns (mostly 17 / 9 digit outputs).
+  struct format_def {
+    const char* name;
+    bool random_bits;
+    uint32_t seed_salt;
+  };
+  const format_def format_defs[] = {
+      {"to_chars_mixed", false, 0x11111111u},
+      {"to_chars_random_bits", true, 0x44444444u},
+  };
+
+  // Reject unknown --scenario names before anything runs, so a typo cannot produce an empty
+  // report.
+  std::vector<std::string> known;
+  for (const auto& def : defs) known.push_back(def.name);
+  for (const auto& def : corpora) known.push_back(def.name);
+  for (const auto& f : file_inputs) known.push_back(f.first);
+  for (const auto& def : format_defs) known.push_back(def.name);
+  for (const std::string& name : only) {
+    if (std::find(known.begin(), known.end(), name) == known.end()) {
+      std::cerr << "error: unknown scenario " << name << "; valid names:";
+      for (const std::string& k : known) std::cerr << " " << k;
+      std::cerr << "\n";
+      return 1;
+    }
+  }
+
   std::vector<scenario_report> reports;
   reports.reserve(std::size(defs));
 
-  for (const auto& def : defs) {
+  // Parse scenario: one report over the inputs as separate strings, one (<name>_arena) over the
+  // same inputs in one contiguous buffer. `scenario_fmt` is a format the inputs also satisfy;
+  // non-general formats get an extra row for the specialized path.
+  auto add_parse_scenarios = [&](const std::string& name, const std::vector<std::string>& inputs,
+                                 chfloat::chars_format scenario_fmt, const char* fmt_name) {
     scenario_report sc;
-    sc.name = def.name;
-    sc.n = n;
+    sc.name = name;
+    sc.n = inputs.size();
     sc.iters = iters;
 
-    auto inputs = make_random_decimal_strings_ex(n, seed ^ def.seed_salt, def.int_min, def.int_max, def.frac_min,
-                                                def.frac_max, def.exp_min, def.exp_max, def.force_exp);
-
     // Warm CPU to reduce first-timed-run volatility.
     warm_cpu_seconds(0.15);
 
@@ -407,6 +1079,56 @@ int main(int argc, char** argv) {
                                         },
                                         iters, stable_runs));
 
+    if (scenario_fmt != chfloat::chars_format::general) {
+      const std::string row_name = std::string("chfloat::from_chars<double> (") + fmt_name + ")";
+      const chfloat::chars_format fmt = scenario_fmt;
+      sc.one_shot.push_back(run_bench(row_name, inputs,
+                                     [fmt](const std::string& s) {
+                                       double v = 0;
+                                       auto r = chfloat::from_chars(s.data(), s.data() + s.size(), v, fmt);
+                                       return (r.ec == chfloat::errc::ok) ? v : 0.0;
+                                     },
+                                     iters));
+      sc.stable.push_back(run_bench_stable(row_name, inputs,
+                                          [fmt](const std::string& s) {
+                                            double v = 0;
+                                            auto r = chfloat::from_chars(s.data(), s.data() + s.size(), v, fmt);
+                                            return (r.ec == chfloat::errc::ok) ? v : 0.0;
+                                          },
+                                          iters, stable_runs));
+    }
+
+    std::string padded_arena;
+    const std::vector<padded_token> padded = make_padded_tokens(inputs, padded_arena);
+    sc.one_shot.push_back(run_bench("chfloat::from_chars_padded<double>", padded,
+                                   [](const padded_token& t) {
+                                     double v = 0;
+                                     auto r = chfloat::from_chars_padded(t.first, t.last, v);
+                                     return (r.ec == chfloat::errc::ok) ? v : 0.0;
+                                   },
+                                   iters));
+    sc.stable.push_back(run_bench_stable("chfloat::from_chars_padded<double>", padded,
+                                        [](const padded_token& t) {
+                                          double v = 0;
+                                          auto r = chfloat::from_chars_padded(t.first, t.last, v);
+                                          return (r.ec == chfloat::errc::ok) ? v : 0.0;
+                                        },
+                                        iters, stable_runs));
+
+    sc.one_shot.push_back(run_bench("chfloat::validate", inputs,
+                                   [](const std::string& s) {
+                                     auto r = chfloat::validate(s.data(), s.data() + s.size());
+                                     return (r.ec == chfloat::errc::ok) ? static_cast<double>(r.ptr - s.data()) : 0.0;
+                                   },
+                                   iters));
+    sc.stable.push_back(run_bench_stable("chfloat::validate", inputs,
+                                        [](const std::string& s) {
+                                          auto r = chfloat::validate(s.data(), s.data() + s.size());
+                                          return (r.ec == chfloat::errc::ok) ? static_cast<double>(r.ptr - s.data())
+                                                                             : 0.0;
+                                        },
+                                        iters, stable_runs));
+
     sc.one_shot.push_back(run_bench("fast_float::from_chars<double>", inputs,
                                    [](const std::string& s) {
                                      double v = 0;
@@ -452,6 +1174,40 @@ int main(int argc, char** argv) {
                                         },
                                         iters, stable_runs));
 
+    if (scenario_fmt != chfloat::chars_format::general) {
+      const std::string row_name = std::string("chfloat::from_chars<float> (") + fmt_name + ")";
+      const chfloat::chars_format fmt = scenario_fmt;
+      sc.one_shot.push_back(run_bench(row_name, inputs,
+                                     [fmt](const std::string& s) {
+                                       float v = 0;
+                                       auto r = chfloat::from_chars(s.data(), s.data() + s.size(), v, fmt);
+                                       return (r.ec == chfloat::errc::ok) ? static_cast<double>(v) : 0.0;
+                                     },
+                                     iters));
+      sc.stable.push_back(run_bench_stable(row_name, inputs,
+                                          [fmt](const std::string& s) {
+                                            float v = 0;
+                                            auto r = chfloat::from_chars(s.data(), s.data() + s.size(), v, fmt);
+                                            return (r.ec == chfloat::errc::ok) ? static_cast<double>(v) : 0.0;
+                                          },
+                                          iters, stable_runs));
+    }
+
+    sc.one_shot.push_back(run_bench("chfloat::from_chars_padded<float>", padded,
+                                   [](const padded_token& t) {
+                                     float v = 0;
+                                     auto r = chfloat::from_chars_padded(t.first, t.last, v);
+                                     return (r.ec == chfloat::errc::ok) ? static_cast<double>(v) : 0.0;
+                                   },
+                                   iters));
+    sc.stable.push_back(run_bench_stable("chfloat::from_chars_padded<float>", padded,
+                                        [](const padded_token& t) {
+                                          float v = 0;
+                                          auto r = chfloat::from_chars_padded(t.first, t.last, v);
+                                          return (r.ec == chfloat::errc::ok) ? static_cast<double>(v) : 0.0;
+                                        },
+                                        iters, stable_runs));
+
     sc.one_shot.push_back(run_bench("fast_float::from_chars<float>", inputs,
                                    [](const std::string& s) {
                                      float v = 0;
@@ -482,6 +1238,261 @@ int main(int argc, char** argv) {
                                         },
                                         iters, stable_runs));
 
+    auto latency = [&](const std::string& row, auto fn) {
+      sc.latency.push_back(run_latency(clock, row, inputs, fn, iters));
+    };
+    latency("chfloat::from_chars<double>", [](const std::string& s) {
+      double v = 0;
+      auto r = chfloat::from_chars(s.data(), s.data() + s.size(), v);
+      return (r.ec == chfloat::errc::ok) ? v : 0.0;
+    });
+    latency("fast_float::from_chars<double>", [](const std::string& s) {
+      double v = 0;
+      auto r = fast_float::from_chars(s.data(), s.data() + s.size(), v);
+      return (r.ec == std::errc{}) ? v : 0.0;
+    });
+    latency("std::strtod", [](const std::string& s) {
+      char* end = nullptr;
+      double v = std::strtod(s.c_str(), &end);
+      return (end != s.c_str()) ? v : 0.0;
+    });
+    latency("chfloat::from_chars<float>", [](const std::string& s) {
+      float v = 0;
+      auto r = chfloat::from_chars(s.data(), s.data() + s.size(), v);
+      return (r.ec == chfloat::errc::ok) ? static_cast<double>(v) : 0.0;
+    });
+    latency("fast_float::from_chars<float>", [](const std::string& s) {
+      float v = 0;
+      auto r = fast_float::from_chars(s.data(), s.data() + s.size(), v);
+      return (r.ec == std::errc{}) ? static_cast<double>(v) : 0.0;
+    });
+    latency("std::strtof", [](const std::string& s) {
+      char* end = nullptr;
+      float v = std::strtof(s.c_str(), &end);
+      return (end != s.c_str()) ? static_cast<double>(v) : 0.0;
+    });
+
+    if (max_threads != 0) {
+      // 1, 2, 4, ... threads, then max_threads itself.
+      std::vector<size_t> counts;
+      for (size_t t = 1; t < max_threads; t *= 2) counts.push_back(t);
+      counts.push_back(max_threads);
+      auto scaling = [&](const std::string& row, auto fn) {
+        for (size_t t : counts) sc.scaling.push_back(run_scaling(row, inputs, fn, iters, t));
+      };
+      scaling("chfloat::from_chars<double>", [](const std::string& s) {
+        double v = 0;
+        auto r = chfloat::from_chars(s.data(), s.data() + s.size(), v);
+        return (r.ec == chfloat::errc::ok) ? v : 0.0;
+      });
+      scaling("chfloat::from_chars<float>", [](const std::string& s) {
+        float v = 0;
+        auto r = chfloat::from_chars(s.data(), s.data() + s.size(), v);
+        return (r.ec == chfloat::errc::ok) ? static_cast<double>(v) : 0.0;
+      });
+      scaling("fast_float::from_chars<double>", [](const std::string& s) {
+        double v = 0;
+        auto r = fast_float::from_chars(s.data(), s.data() + s.size(), v);
+        return (r.ec == std::errc{}) ? v : 0.0;
+      });
+    }
+
+    reports.push_back(std::move(sc));
+
+    // Same inputs in one contiguous buffer: per-call parsers walk it number by number, the batch
+    // API takes it in one call.
+    scenario_report ac;
+    ac.name = name + "_arena";
+    ac.n = inputs.size();
+    ac.iters = iters;
+    const std::vector<number_arena> arena = {make_arena(inputs)};
+    std::vector<double> dbuf(inputs.size());
+    std::vector<float> fbuf(inputs.size());
+
+    warm_cpu_seconds(0.15);
+
+    auto add = [&](const std::string& row_name, auto fn) {
+      ac.one_shot.push_back(run_bench(row_name, arena, fn, iters));
+      ac.stable.push_back(run_bench_stable(row_name, arena, fn, iters, stable_runs));
+    };
+
+    add("chfloat::from_chars<double>", [](const number_arena& a) {
+      double sum = 0;
+      for (const char* p = a.first(); p < a.last();) {
+        double v = 0;
+        auto r = chfloat::from_chars(p, a.last(), v);
+        sum += v;
+        p = r.ptr + 1;
+      }
+      return sum;
+    });
+    add("chfloat::from_chars_padded<double>", [](const number_arena& a) {
+      double sum = 0;
+      for (const char* p = a.first(); p < a.last();) {
+        double v = 0;
+        auto r = chfloat::from_chars_padded(p, a.last(), v);
+        sum += v;
+        p = r.ptr + 1;
+      }
+      return sum;
+    });
+    add("chfloat::from_chars_many<double>", [&dbuf](const number_arena& a) { return parse_arena_many(a, dbuf); });
+    add("fast_float::from_chars<double>", [](const number_arena& a) {
+      double sum = 0;
+      for (const char* p = a.first(); p < a.last();) {
+        double v = 0;
+        auto r = fast_float::from_chars(p, a.last(), v);
+        sum += v;
+        p = r.ptr + 1;
+      }
+      return sum;
+    });
+    add("std::strtod", [](const number_arena& a) {
+      double sum = 0;
+      for (const char* p = a.first(); p < a.last();) {
+        char* end = nullptr;
+        sum += std::strtod(p, &end);
+        p = (end != p) ? end + 1 : p + 1;
+      }
+      return sum;
+    });
+
+    add("chfloat::from_chars<float>", [](const number_arena& a) {
+      double sum = 0;
+      for (const char* p = a.first(); p < a.last();) {
+        float v = 0;
+        auto r = chfloat::from_chars(p, a.last(), v);
+        sum += v;
+        p = r.ptr + 1;
+      }
+      return sum;
+    });
+    add("chfloat::from_chars_padded<float>", [](const number_arena& a) {
+      double sum = 0;
+      for (const char* p = a.first(); p < a.last();) {
+        float v = 0;
+        auto r = chfloat::from_chars_padded(p, a.last(), v);
+        sum += v;
+        p = r.ptr + 1;
+      }
+      return sum;
+    });
+    add("chfloat::from_chars_many<float>", [&fbuf](const number_arena& a) { return parse_arena_many(a, fbuf); });
+    add("fast_float::from_chars<float>", [](const number_arena& a) {
+      double sum = 0;
+      for (const char* p = a.first(); p < a.last();) {
+        float v = 0;
+        auto r = fast_float::from_chars(p, a.last(), v);
+        sum += v;
+        p = r.ptr + 1;
+      }
+      return sum;
+    });
+    add("std::strtof", [](const number_arena& a) {
+      double sum = 0;
+      for (const char* p = a.first(); p < a.last();) {
+        char* end = nullptr;
+        sum += std::strtof(p, &end);
+        p = (end != p) ? end + 1 : p + 1;
+      }
+      return sum;
+    });
+
+    reports.push_back(std::move(ac));
+  };
+
+  for (const auto& def : defs) {
+    if (!wanted(def.name)) continue;
+    add_parse_scenarios(def.name,
+                        make_random_decimal_strings_ex(n, seed ^ def.seed_salt, def.int_min, def.int_max, def.frac_min,
+                                                       def.frac_max, def.exp_min, def.exp_max, def.force_exp),
+                        def.fmt, def.fmt_name);
+  }
+
+  for (const auto& def : corpora) {
+    if (!wanted(def.name)) continue;
+    add_parse_scenarios(def.name, def.make(n, seed ^ def.seed_salt), chfloat::chars_format::general, "general");
+  }
+
+  for (const auto& f : file_inputs) {
+    if (wanted(f.first)) add_parse_scenarios(f.first, f.second, chfloat::chars_format::general, "general");
+  }
+
+  for (const auto& def : format_defs) {
+    if (!wanted(def.name)) continue;
+    scenario_report sc;
+    sc.name = def.name;
+    sc.n = n;
+    sc.iters = iters;
+
+    std::vector<double> dv;
+    std::vector<float> fv;
+    dv.reserve(n);
+    fv.reserve(n);
+    if (def.random_bits) {
+      std::mt19937_64 rng(seed ^ def.seed_salt);
+      while (dv.size() < n) {
+        const uint64_t bits = rng();
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        float f;
+        const uint32_t fbits = static_cast<uint32_t>(bits >> 32);
+        std::memcpy(&f, &fbits, sizeof(f));
+        if (std::isfinite(d) && std::isfinite(f)) {
+          dv.push_back(d);
+          fv.push_back(f);
+        }
+      }
+    } else {
+      for (const std::string& s : make_random_decimal_strings_ex(n, seed ^ def.seed_salt, 1, 8, 0, 8, -30, 30, false)) {
+        dv.push_back(std::strtod(s.c_str(), nullptr));
+        fv.push_back(std::strtof(s.c_str(), nullptr));
+      }
+    }
+
+    warm_cpu_seconds(0.15);
+
+    auto add = [&](const std::string& name, const auto& inputs, auto fn) {
+      sc.one_shot.push_back(run_bench(name, inputs, fn, iters));
+      sc.stable.push_back(run_bench_stable(name, inputs, fn, iters, stable_runs));
+    };
+
+    add("chfloat::to_chars<double>", dv, [](double v) {
+      char buf[32];
+      auto r = chfloat::to_chars(buf, buf + sizeof(buf), v);
+      return static_cast<double>((r.ptr - buf) + buf[0]);
+    });
+#if defined(__cpp_lib_to_chars)
+    add("std::to_chars<double>", dv, [](double v) {
+      char buf[32];
+      auto r = std::to_chars(buf, buf + sizeof(buf), v);
+      return static_cast<double>((r.ptr - buf) + buf[0]);
+    });
+#endif
+    add("std::snprintf(%.17g)", dv, [](double v) {
+      char buf[32];
+      const int len = std::snprintf(buf, sizeof(buf), "%.17g", v);
+      return static_cast<double>(len + buf[0]);
+    });
+
+    add("chfloat::to_chars<float>", fv, [](float v) {
+      char buf[32];
+      auto r = chfloat::to_chars(buf, buf + sizeof(buf), v);
+      return static_cast<double>((r.ptr - buf) + buf[0]);
+    });
+#if defined(__cpp_lib_to_chars)
+    add("std::to_chars<float>", fv, [](float v) {
+      char buf[32];
+      auto r = std::to_chars(buf, buf + sizeof(buf), v);
+      return static_cast<double>((r.ptr - buf) + buf[0]);
+    });
+#endif
+    add("std::snprintf(%.9g)", fv, [](float v) {
+      char buf[32];
+      const int len = std::snprintf(buf, sizeof(buf), "%.9g", static_cast<double>(v));
+      return static_cast<double>(len + buf[0]);
+    });
+
     reports.push_back(std::move(sc));
   }
 
@@ -492,7 +1503,7 @@ int main(int argc, char** argv) {
 #else
   report_path = std::string("report/benchmark.md");
 #endif
-  write_markdown_report(report_path, reports, stable_runs);
+  write_markdown_report(report_path, reports, stable_runs, clock);
 
   // Also print a short summary to stdout.
   std::cout << "Wrote " << report_path << "\n";
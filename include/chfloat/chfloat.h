@@ -4,6 +4,7 @@
 // chfloat: header-only numeric parsing helpers.
 // Public API is pointer-based (first,last) to avoid std::string_view.
 
+#include <chfloat/detail/float_format.h>
 #include <chfloat/detail/float_parse.h>
 
 namespace chfloat {
@@ -13,6 +14,7 @@ enum class errc : int {
   ok = 0,
   invalid_argument = 1,
   result_out_of_range = 2,
+  value_too_large = 3,
 };
 
 struct from_chars_result {
@@ -25,6 +27,7 @@ enum class chars_format : unsigned {
   scientific = 1,
   fixed = 2,
   hex = 3,
+  json = 4, // RFC 8259 number grammar; see from_chars_json
 };
 
 namespace detail {
@@ -41,20 +44,8 @@ inline const char* skip_leading_ascii_spaces(const char* first, const char* last
   return first;
 }
 
-inline int digit_value(unsigned char c) noexcept {
-  if (c >= static_cast<unsigned char>('0') && c <= static_cast<unsigned char>('9')) {
-    return int(c - static_cast<unsigned char>('0'));
-  }
-  if (c >= static_cast<unsigned char>('a') && c <= static_cast<unsigned char>('z')) {
-    return 10 + int(c - static_cast<unsigned char>('a'));
-  }
-  if (c >= static_cast<unsigned char>('A') && c <= static_cast<unsigned char>('Z')) {
-    return 10 + int(c - static_cast<unsigned char>('A'));
-  }
-  return -1;
-}
-
-// Unsigned parser with overflow detection, for unsigned long long.
+// Runtime-base unsigned parser with overflow detection, for unsigned long long. The common
+// bases are dispatched to the compile-time kernels below instead.
 inline from_chars_result parse_ull_any_base(const char* first, const char* last,
                                            unsigned long long& out, int base) noexcept {
   if (base < 2 || base > 36) return {first, errc::invalid_argument};
@@ -68,8 +59,8 @@ inline from_chars_result parse_ull_any_base(const char* first, const char* last,
   const unsigned long long ub = static_cast<unsigned long long>(base);
 
   for (; p < last; ++p) {
-    int dv = digit_value(static_cast<unsigned char>(*p));
-    if (dv < 0 || dv >= base) break;
+    const int dv = static_cast<int>(digit_in_base36(*p));
+    if (dv >= base) break;
     any = true;
 
     const unsigned long long ud = static_cast<unsigned long long>(dv);
@@ -77,8 +68,7 @@ inline from_chars_result parse_ull_any_base(const char* first, const char* last,
       // overflow: consume remaining digits
       ++p;
       for (; p < last; ++p) {
-        int dv2 = digit_value(static_cast<unsigned char>(*p));
-        if (dv2 < 0 || dv2 >= base) break;
+        if (static_cast<int>(digit_in_base36(*p)) >= base) break;
       }
       return {p, errc::result_out_of_range};
     }
@@ -90,89 +80,616 @@ inline from_chars_result parse_ull_any_base(const char* first, const char* last,
   return {p, errc::ok};
 }
 
+// Base-10 fast path: digits are converted up to 8 at a time (SWAR) and overflow is decided by
+// the significant digit count; only a 20-digit unsigned long long needs a value comparison.
+// U is a 32- or 64-bit unsigned type. Same results (and ptr on overflow) as parse_ull_any_base.
+template <class U>
+inline from_chars_result parse_uint_dec(const char* first, const char* last, U& out) noexcept {
+  static_assert(sizeof(U) == 4 || sizeof(U) == 8, "32- or 64-bit unsigned type expected");
+  const char* p = first;
+  while (p < last && *p == '0') ++p;
+  const char* const sig = p;
+
+  u64 v = 0;
+  while ((last - p) >= 8) {
+    // Digits in this word: the lowest flagged byte of the all_8_digits test is the first non-digit.
+    const u64 w = load_u64_unaligned(p);
+    const u64 nd = ((w + 0x4646464646464646ULL) | (w - 0x3030303030303030ULL)) & 0x8080808080808080ULL;
+    const int k = (nd == 0) ? 8 : (tz64(nd) >> 3);
+    if (k == 0 || ((p - sig) + k) > 19) break;
+    const u64 wk = (k == 8) ? w : ((w << (8 * (8 - k))) | (0x3030303030303030ULL >> (8 * k)));
+    v = v * pow10_u64(k) + eight_digits_to_u32(wk);
+    p += k;
+    if (k != 8) break;
+  }
+  for (; p < last; ++p) {
+    const unsigned d = digit_u8(static_cast<unsigned char>(*p));
+    if (d > 9) break;
+    if ((p - sig) >= 19) {
+      // 1844674407370955161 * 10 + 5 == 2^64 - 1.
+      if (sizeof(U) == 8 && (p - sig) == 19 &&
+          (v < 1844674407370955161ULL || (v == 1844674407370955161ULL && d <= 5))) {
+        v = v * 10ULL + d;
+        continue;
+      }
+      while (p < last && digit_u8(static_cast<unsigned char>(*p)) <= 9) ++p;
+      return {p, errc::result_out_of_range};
+    }
+    v = v * 10ULL + d;
+  }
+
+  if (p == first) return {first, errc::invalid_argument};
+  if (sizeof(U) < 8 && v > static_cast<u64>(static_cast<U>(~U(0)))) return {p, errc::result_out_of_range};
+  out = static_cast<U>(v);
+  return {p, errc::ok};
+}
+
+// Compile-time base kernels. U is a 32- or 64-bit unsigned type; all of them return the same
+// results (and ptr on overflow: past the whole digit run) as parse_ull_any_base.
+//   - 10: parse_uint_dec.
+//   - 2, 4, 8, 16, 32: shift accumulation, overflow when a shift would push out set bits.
+//   - others: constant cutoff/limit comparison (no division at run time).
+//   - 0: the runtime `base` argument, through parse_ull_any_base.
+template <int Base, class U>
+inline from_chars_result parse_uint_base(const char* first, const char* last, U& out, int base = Base) noexcept {
+  static_assert(sizeof(U) == 4 || sizeof(U) == 8, "32- or 64-bit unsigned type expected");
+  static_assert(Base == 0 || (Base >= 2 && Base <= 36), "base must be in [2, 36]");
+  if constexpr (Base == 10) {
+    (void)base;
+    return parse_uint_dec(first, last, out);
+  } else if constexpr (Base == 0) {
+    unsigned long long v = 0;
+    from_chars_result r = parse_ull_any_base(first, last, v, base);
+    if (r.ec != errc::ok) return r;
+    if (sizeof(U) < 8 && v > static_cast<unsigned long long>(static_cast<U>(~U(0)))) {
+      return {r.ptr, errc::result_out_of_range};
+    }
+    out = static_cast<U>(v);
+    return r;
+  } else {
+    (void)base;
+    constexpr U umax = static_cast<U>(~U(0));
+    constexpr bool pow2 = (Base & (Base - 1)) == 0;
+    constexpr int shift = (Base == 2) ? 1 : (Base == 4) ? 2 : (Base == 8) ? 3 : (Base == 16) ? 4 : 5;
+    constexpr U cutoff = umax / static_cast<U>(Base);
+    constexpr unsigned cutlim = static_cast<unsigned>(umax % static_cast<U>(Base));
+
+    U v = 0;
+    const char* p = first;
+    for (; p < last; ++p) {
+      const unsigned d = digit_in_base36(*p);
+      if (d >= static_cast<unsigned>(Base)) break;
+      const bool overflow = pow2 ? ((v >> (sizeof(U) * 8 - shift)) != 0) : (v > cutoff || (v == cutoff && d > cutlim));
+      if (overflow) {
+        while (p < last && digit_in_base36(*p) < static_cast<unsigned>(Base)) ++p;
+        return {p, errc::result_out_of_range};
+      }
+      v = pow2 ? static_cast<U>((v << shift) | d) : static_cast<U>(v * static_cast<U>(Base) + d);
+    }
+    if (p == first) return {first, errc::invalid_argument};
+    out = v;
+    return {p, errc::ok};
+  }
+}
+
+template <class T>
+struct integer_traits;
+template <>
+struct integer_traits<int> {
+  using unsigned_type = unsigned;
+};
+template <>
+struct integer_traits<long> {
+  using unsigned_type = unsigned long;
+};
+template <>
+struct integer_traits<long long> {
+  using unsigned_type = unsigned long long;
+};
+template <>
+struct integer_traits<unsigned> {
+  using unsigned_type = unsigned;
+};
+template <>
+struct integer_traits<unsigned long> {
+  using unsigned_type = unsigned long;
+};
+template <>
+struct integer_traits<unsigned long long> {
+  using unsigned_type = unsigned long long;
+};
+
+// Integer parse in a compile-time base (0: runtime `base`). Signed types take an optional
+// '+'/'-' and are range-checked on the magnitude; unsigned types reject any sign.
+template <int Base, class T>
+inline from_chars_result parse_integer_base(const char* first, const char* last, T& value, int base = Base) noexcept {
+  using U = typename integer_traits<T>::unsigned_type;
+  if constexpr (static_cast<T>(-1) > T(0)) {
+    if (first != last && (*first == '-' || *first == '+')) return {first, errc::invalid_argument};
+    return parse_uint_base<Base>(first, last, value, base);
+  } else {
+    const char* p = first;
+    bool negative = false;
+    if (p < last && (*p == '-' || *p == '+')) {
+      negative = (*p == '-');
+      ++p;
+    }
+
+    U mag = 0;
+    from_chars_result r = parse_uint_base<Base>(p, last, mag, base);
+    if (r.ec != errc::ok) {
+      if (r.ec == errc::invalid_argument) return {first, errc::invalid_argument};
+      return r;
+    }
+
+    const U pos_max = static_cast<U>(~U(0)) >> 1;
+    if (!negative) {
+      if (mag > pos_max) return {r.ptr, errc::result_out_of_range};
+      value = static_cast<T>(mag);
+      return r;
+    }
+    if (mag > pos_max + 1) return {r.ptr, errc::result_out_of_range};
+    value = (mag == pos_max + 1) ? static_cast<T>(-static_cast<T>(pos_max) - 1) : -static_cast<T>(mag);
+    return r;
+  }
+}
+
+// Runtime base: the common bases get their constant-folded kernels.
+template <class T>
+inline from_chars_result parse_integer(const char* first, const char* last, T& value, int base) noexcept {
+  switch (base) {
+    case 10:
+      return parse_integer_base<10>(first, last, value);
+    case 16:
+      return parse_integer_base<16>(first, last, value);
+    case 2:
+      return parse_integer_base<2>(first, last, value);
+    case 8:
+      return parse_integer_base<8>(first, last, value);
+    default:
+      return parse_integer_base<0>(first, last, value, base);
+  }
+}
+
 } // namespace detail
 
 // Strict parsing (no whitespace skipping).
+// With CHFLOAT_HAS_CONSTEXPR_FROM_CHARS (C++20, see float_parse.h) the floating-point
+// overloads and from_chars_json are constexpr, e.g. for tables built from decimal literals:
+//   constexpr double parse(const char* s, const char* e) { double v = 0; chfloat::from_chars(s, e, v); return v; }
+
+CHFLOAT_CONSTEXPR20 inline from_chars_result from_chars(const char* first, const char* last, double& value,
+                                                        chars_format fmt = chars_format::general) noexcept {
+  detail::fp_chars_result r;
+  switch (fmt) {
+    case chars_format::general:
+      r = detail::parse_fp_double(first, last, value);
+      break;
+    case chars_format::fixed:
+      r = detail::parse_fp_double<detail::fp_fmt_fixed>(first, last, value);
+      break;
+    case chars_format::scientific:
+      r = detail::parse_fp_double<detail::fp_fmt_scientific>(first, last, value);
+      break;
+    case chars_format::hex:
+      r = detail::parse_fp_hex_double(first, last, value);
+      break;
+    case chars_format::json: {
+      const detail::fp_json_result j = detail::parse_fp_json(first, last, value);
+      return {j.ptr, static_cast<errc>(j.ec)};
+    }
+    default:
+      return {first, errc::invalid_argument};
+  }
+  return {r.ptr, static_cast<errc>(r.ec)};
+}
 
-inline from_chars_result from_chars(const char* first, const char* last, double& value,
-                                    chars_format fmt = chars_format::general) noexcept {
-  if (fmt != chars_format::general) {
-    // Non-general formats are not supported in the nostd build.
-    return {first, errc::invalid_argument};
+CHFLOAT_CONSTEXPR20 inline from_chars_result from_chars(const char* first, const char* last, float& value,
+                                                        chars_format fmt = chars_format::general) noexcept {
+  detail::fp_chars_result r;
+  switch (fmt) {
+    case chars_format::general:
+      r = detail::parse_fp_float(first, last, value);
+      break;
+    case chars_format::fixed:
+      r = detail::parse_fp_float<detail::fp_fmt_fixed>(first, last, value);
+      break;
+    case chars_format::scientific:
+      r = detail::parse_fp_float<detail::fp_fmt_scientific>(first, last, value);
+      break;
+    case chars_format::hex:
+      r = detail::parse_fp_hex_float(first, last, value);
+      break;
+    case chars_format::json: {
+      const detail::fp_json_result j = detail::parse_fp_json(first, last, value);
+      return {j.ptr, static_cast<errc>(j.ec)};
+    }
+    default:
+      return {first, errc::invalid_argument};
   }
-  detail::fp_chars_result r = detail::parse_fp_double(first, last, value);
   return {r.ptr, static_cast<errc>(r.ec)};
 }
 
-inline from_chars_result from_chars(const char* first, const char* last, float& value,
-                                    chars_format fmt = chars_format::general) noexcept {
-  if (fmt != chars_format::general) {
-    return {first, errc::invalid_argument};
+// UTF-16 and UTF-32 input (char16_t, char32_t, wchar_t code units), parsed in place without a
+// transcoding copy. Same grammar, values and errors as the char overloads; a code unit outside
+// ASCII is never part of a number, even when its low byte is an ASCII digit.
+
+template <class CharT>
+struct basic_from_chars_result {
+  const CharT* ptr;
+  errc ec;
+};
+
+namespace detail {
+
+template <class CharT>
+CHFLOAT_CONSTEXPR20 inline basic_from_chars_result<CharT> from_chars_units(const CharT* first, const CharT* last,
+                                                                           double& value, chars_format fmt) noexcept {
+  basic_fp_chars_result<CharT> r{first, fp_invalid_argument};
+  switch (fmt) {
+    case chars_format::general:
+      r = parse_fp_double(first, last, value);
+      break;
+    case chars_format::fixed:
+      r = parse_fp_double<fp_fmt_fixed>(first, last, value);
+      break;
+    case chars_format::scientific:
+      r = parse_fp_double<fp_fmt_scientific>(first, last, value);
+      break;
+    case chars_format::hex:
+      r = parse_fp_hex_double(first, last, value);
+      break;
+    case chars_format::json: {
+      const basic_fp_json_result<CharT> j = parse_fp_json(first, last, value);
+      return {j.ptr, static_cast<errc>(j.ec)};
+    }
+    default:
+      break;
   }
-  detail::fp_chars_result r = detail::parse_fp_float(first, last, value);
   return {r.ptr, static_cast<errc>(r.ec)};
 }
 
-inline from_chars_result from_chars(const char* first, const char* last, long long& value,
-                                    int base = 10) noexcept {
-  if (first == last) return {first, errc::invalid_argument};
+template <class CharT>
+CHFLOAT_CONSTEXPR20 inline basic_from_chars_result<CharT> from_chars_units(const CharT* first, const CharT* last,
+                                                                           float& value, chars_format fmt) noexcept {
+  basic_fp_chars_result<CharT> r{first, fp_invalid_argument};
+  switch (fmt) {
+    case chars_format::general:
+      r = parse_fp_float(first, last, value);
+      break;
+    case chars_format::fixed:
+      r = parse_fp_float<fp_fmt_fixed>(first, last, value);
+      break;
+    case chars_format::scientific:
+      r = parse_fp_float<fp_fmt_scientific>(first, last, value);
+      break;
+    case chars_format::hex:
+      r = parse_fp_hex_float(first, last, value);
+      break;
+    case chars_format::json: {
+      const basic_fp_json_result<CharT> j = parse_fp_json(first, last, value);
+      return {j.ptr, static_cast<errc>(j.ec)};
+    }
+    default:
+      break;
+  }
+  return {r.ptr, static_cast<errc>(r.ec)};
+}
 
-  const char* p = first;
-  bool negative = false;
-  if (*p == '-') {
-    negative = true;
-    ++p;
-  } else if (*p == '+') {
-    ++p;
+} // namespace detail
+
+CHFLOAT_CONSTEXPR20 inline basic_from_chars_result<char16_t>
+from_chars(const char16_t* first, const char16_t* last, double& value,
+           chars_format fmt = chars_format::general) noexcept {
+  return detail::from_chars_units(first, last, value, fmt);
+}
+
+CHFLOAT_CONSTEXPR20 inline basic_from_chars_result<char16_t>
+from_chars(const char16_t* first, const char16_t* last, float& value,
+           chars_format fmt = chars_format::general) noexcept {
+  return detail::from_chars_units(first, last, value, fmt);
+}
+
+CHFLOAT_CONSTEXPR20 inline basic_from_chars_result<char32_t>
+from_chars(const char32_t* first, const char32_t* last, double& value,
+           chars_format fmt = chars_format::general) noexcept {
+  return detail::from_chars_units(first, last, value, fmt);
+}
+
+CHFLOAT_CONSTEXPR20 inline basic_from_chars_result<char32_t>
+from_chars(const char32_t* first, const char32_t* last, float& value,
+           chars_format fmt = chars_format::general) noexcept {
+  return detail::from_chars_units(first, last, value, fmt);
+}
+
+CHFLOAT_CONSTEXPR20 inline basic_from_chars_result<wchar_t>
+from_chars(const wchar_t* first, const wchar_t* last, double& value,
+           chars_format fmt = chars_format::general) noexcept {
+  return detail::from_chars_units(first, last, value, fmt);
+}
+
+CHFLOAT_CONSTEXPR20 inline basic_from_chars_result<wchar_t>
+from_chars(const wchar_t* first, const wchar_t* last, float& value,
+           chars_format fmt = chars_format::general) noexcept {
+  return detail::from_chars_units(first, last, value, fmt);
+}
+
+// JSON numbers (RFC 8259): -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?, checked in the same
+// pass that parses the value. A leading '+', leading zeros ("01"), a bare or trailing '.' and
+// nan/inf are invalid_argument rather than a shorter match; the byte at ptr is left to the
+// caller's tokenizer. Same value and out-of-range handling as from_chars.
+//   - integer: the literal had neither a fraction nor an exponent, so from_chars(long long)
+//     on [first, ptr) holds it exactly when it is in range.
+
+struct from_chars_json_result {
+  const char* ptr;
+  errc ec;
+  bool integer;
+};
+
+CHFLOAT_CONSTEXPR20 inline from_chars_json_result from_chars_json(const char* first, const char* last,
+                                                                  double& value) noexcept {
+  const detail::fp_json_result r = detail::parse_fp_json(first, last, value);
+  return {r.ptr, static_cast<errc>(r.ec), r.integer};
+}
+
+CHFLOAT_CONSTEXPR20 inline from_chars_json_result from_chars_json(const char* first, const char* last,
+                                                                  float& value) noexcept {
+  const detail::fp_json_result r = detail::parse_fp_json(first, last, value);
+  return {r.ptr, static_cast<errc>(r.ec), r.integer};
+}
+
+// Padded parsing: the results of from_chars, for callers that guarantee at least
+// from_chars_padding readable bytes past `last` (any content; it never becomes part of the
+// number). Digit, dot and exponent scanning then always loads full words or blocks instead of
+// finishing short tokens byte by byte. chars_format::hex and json take the regular path.
+inline constexpr unsigned from_chars_padding = static_cast<unsigned>(detail::fp_padding);
+
+inline from_chars_result from_chars_padded(const char* first, const char* last, double& value,
+                                           chars_format fmt = chars_format::general) noexcept {
+  detail::fp_chars_result r;
+  switch (fmt) {
+    case chars_format::general:
+      r = detail::parse_fp_double<detail::fp_fmt_general, true>(first, last, value);
+      break;
+    case chars_format::fixed:
+      r = detail::parse_fp_double<detail::fp_fmt_fixed, true>(first, last, value);
+      break;
+    case chars_format::scientific:
+      r = detail::parse_fp_double<detail::fp_fmt_scientific, true>(first, last, value);
+      break;
+    case chars_format::hex:
+      r = detail::parse_fp_hex_double(first, last, value);
+      break;
+    case chars_format::json:
+      return from_chars(first, last, value, fmt);
+    default:
+      return {first, errc::invalid_argument};
   }
+  return {r.ptr, static_cast<errc>(r.ec)};
+}
 
-  unsigned long long mag = 0;
-  auto r = detail::parse_ull_any_base(p, last, mag, base);
-  if (r.ec != errc::ok) {
-    if (r.ec == errc::invalid_argument) return {first, errc::invalid_argument};
-    return r;
+inline from_chars_result from_chars_padded(const char* first, const char* last, float& value,
+                                           chars_format fmt = chars_format::general) noexcept {
+  detail::fp_chars_result r;
+  switch (fmt) {
+    case chars_format::general:
+      r = detail::parse_fp_float<detail::fp_fmt_general, true>(first, last, value);
+      break;
+    case chars_format::fixed:
+      r = detail::parse_fp_float<detail::fp_fmt_fixed, true>(first, last, value);
+      break;
+    case chars_format::scientific:
+      r = detail::parse_fp_float<detail::fp_fmt_scientific, true>(first, last, value);
+      break;
+    case chars_format::hex:
+      r = detail::parse_fp_hex_float(first, last, value);
+      break;
+    case chars_format::json:
+      return from_chars(first, last, value, fmt);
+    default:
+      return {first, errc::invalid_argument};
+  }
+  return {r.ptr, static_cast<errc>(r.ec)};
+}
+
+// Validation only: the ptr/ec that from_chars(double, fmt) would return, without converting.
+// ok means [first, ptr) is a number in that grammar; since no value is computed, numbers that
+// from_chars reports as result_out_of_range (e.g. "1e400") are ok here.
+inline from_chars_result validate(const char* first, const char* last,
+                                  chars_format fmt = chars_format::general) noexcept {
+  detail::fp_chars_result r;
+  switch (fmt) {
+    case chars_format::general:
+      r = detail::validate_fp<detail::fp_fmt_general>(first, last);
+      break;
+    case chars_format::fixed:
+      r = detail::validate_fp<detail::fp_fmt_fixed>(first, last);
+      break;
+    case chars_format::scientific:
+      r = detail::validate_fp<detail::fp_fmt_scientific>(first, last);
+      break;
+    case chars_format::hex:
+      r = detail::validate_fp<detail::fp_fmt_hex>(first, last);
+      break;
+    case chars_format::json:
+      r = detail::validate_fp<detail::fp_fmt_json>(first, last);
+      break;
+    default:
+      return {first, errc::invalid_argument};
   }
+  return {r.ptr, static_cast<errc>(r.ec)};
+}
+
+// Fixed-point parsing: value = x * 10^scale rounded to nearest (ties to even), computed from
+// the decimal digits without going through double, e.g. "12.3456" with scale 4 -> 123456.
+// Accepts the general float grammar except nan/inf.
+//   - ok: exact is false when digits had to be rounded away.
+//   - result_out_of_range: the result does not fit in long long; value is unchanged.
+
+struct from_chars_scaled_result {
+  const char* ptr;
+  errc ec;
+  bool exact;
+};
 
-  // signed range checks
-  const unsigned long long pos_max = static_cast<unsigned long long>(0x7fffffffffffffffULL);
-  const unsigned long long neg_max = pos_max + 1ULL;
-  if (!negative) {
-    if (mag > pos_max) return {r.ptr, errc::result_out_of_range};
-    value = static_cast<long long>(mag);
-    return {r.ptr, errc::ok};
+inline from_chars_scaled_result from_chars_scaled(const char* first, const char* last, long long& value,
+                                                  int scale) noexcept {
+  detail::fp_scaled_result r = detail::parse_scaled_i64(first, last, value, scale);
+  return {r.ptr, static_cast<errc>(r.ec), r.exact};
+}
+
+// Decimal decomposition: the first half of from_chars, before any binary conversion.
+// parse_decimal splits "-123.45e2" into {12345, 0, negative}; to_double / to_float later give
+// exactly what from_chars would have returned for the same text.
+//
+// Up to 19 significant digits are kept in `mantissa`. When more non-zero digits follow,
+// `exact` is false and the conversions re-read the source digits [digits, digits_end), so that
+// text must still be alive. A decimal built by hand needs exact = true (digits are ignored).
+
+struct decimal {
+  unsigned long long mantissa;
+  int exponent; // value = mantissa * 10^exponent
+  bool negative;
+  bool exact;
+  const char* digits;     // first digit or '.', past the sign
+  const char* digits_end; // end of the parsed number
+};
+
+namespace detail {
+
+inline dec64 to_dec64(const decimal& d) noexcept {
+  dec64 r;
+  r.mant = d.mantissa;
+  r.exp10 = d.exponent;
+  r.neg = d.negative;
+  r.exact = d.exact;
+  r.ptr = d.digits_end;
+  r.ec = fp_ok;
+  r.digits = d.digits;
+  r.integer = false;
+  return r;
+}
+
+} // namespace detail
+
+// Same grammar as from_chars(double) with chars_format::general, except nan/inf, which have no
+// decimal form (invalid_argument).
+inline from_chars_result parse_decimal(const char* first, const char* last, decimal& out) noexcept {
+  const char* p = first;
+  bool neg = false;
+  if (p < last && (*p == '-' || *p == '+')) {
+    neg = (*p == '-');
+    ++p;
   }
-  if (mag > neg_max) return {r.ptr, errc::result_out_of_range};
-  value = (mag == neg_max) ? static_cast<long long>(0x8000000000000000ULL)
-                           : -static_cast<long long>(mag);
-  return {r.ptr, errc::ok};
+  const detail::dec64 d = detail::parse_decimal_19_impl(p, last, neg);
+  if (d.ec != detail::fp_ok) return {first, static_cast<errc>(d.ec)};
+  out.mantissa = d.mant;
+  out.exponent = d.exp10;
+  out.negative = d.neg;
+  out.exact = d.exact;
+  out.digits = d.digits;
+  out.digits_end = d.ptr;
+  return {d.ptr, errc::ok};
+}
+
+inline errc to_double(const decimal& d, double& value) noexcept {
+  return static_cast<errc>(detail::dec64_to_double(detail::to_dec64(d), value));
+}
+
+inline errc to_float(const decimal& d, float& value) noexcept {
+  // from_chars(float) keeps only 10 digits; its shortcuts are only valid for mantissas that short.
+  const detail::dec64 d64 = detail::to_dec64(d);
+  const int ec = (d.mantissa <= 9999999999ULL) ? detail::dec64_to_float(d64, value)
+                                               : detail::dec64_to_float_wide(d64, value);
+  return static_cast<errc>(ec);
+}
+
+inline from_chars_result from_chars(const char* first, const char* last, long long& value,
+                                    int base = 10) noexcept {
+  return detail::parse_integer(first, last, value, base);
 }
 
 inline from_chars_result from_chars(const char* first, const char* last, unsigned long long& value,
                                     int base = 10) noexcept {
-  if (first == last) return {first, errc::invalid_argument};
-  if (*first == '-' || *first == '+') return {first, errc::invalid_argument};
-  return detail::parse_ull_any_base(first, last, value, base);
+  return detail::parse_integer(first, last, value, base);
 }
 
 inline from_chars_result from_chars(const char* first, const char* last, int& value,
                                     int base = 10) noexcept {
-  long long v = 0;
-  auto r = from_chars(first, last, v, base);
-  if (r.ec != errc::ok) return r;
-  // assume 32-bit int on supported targets
-  if (v < -2147483648LL || v > 2147483647LL) return {r.ptr, errc::result_out_of_range};
-  value = static_cast<int>(v);
-  return r;
+  return detail::parse_integer(first, last, value, base);
 }
 
 inline from_chars_result from_chars(const char* first, const char* last, unsigned& value,
                                     int base = 10) noexcept {
-  unsigned long long v = 0;
-  auto r = from_chars(first, last, v, base);
-  if (r.ec != errc::ok) return r;
-  if (v > 0xffffffffULL) return {r.ptr, errc::result_out_of_range};
-  value = static_cast<unsigned>(v);
-  return r;
+  return detail::parse_integer(first, last, value, base);
+}
+
+// `long`/`unsigned long` are distinct types from `long long`/`int` on every target (and are the
+// int64_t/uint64_t typedefs on LP64), so they get their own overloads.
+inline from_chars_result from_chars(const char* first, const char* last, long& value, int base = 10) noexcept {
+  return detail::parse_integer(first, last, value, base);
+}
+
+inline from_chars_result from_chars(const char* first, const char* last, unsigned long& value,
+                                    int base = 10) noexcept {
+  return detail::parse_integer(first, last, value, base);
+}
+
+// Compile-time base: chfloat::from_chars<16>(first, last, value). Same results as the runtime
+// overloads; Base must be in [2, 36], T one of the integer types above.
+template <int Base, class T>
+inline from_chars_result from_chars(const char* first, const char* last, T& value) noexcept {
+  static_assert(Base >= 2 && Base <= 36, "base must be in [2, 36]");
+  return detail::parse_integer_base<Base>(first, last, value);
+}
+
+// Batch parsing of separator-delimited numbers into a caller-provided buffer.
+//
+// Parses "v0<sep>v1<sep>...<sep>vN" (a trailing separator is accepted) until `last`, or until
+// `cap` values have been written to `out`. Each value follows the same grammar as from_chars.
+//   - ok: ptr is `last` or, if cap was reached, the start of the next unparsed token.
+//   - error: ptr is the start of the offending token; count values were stored before it.
+// Garbage between a number and the next separator (e.g. "1.5x") makes that token an error.
+
+struct from_chars_many_result {
+  const char* ptr;
+  detail::usize count;
+  errc ec;
+};
+
+inline from_chars_many_result from_chars_many(const char* first, const char* last, char delimiter, double* out,
+                                              detail::usize cap) noexcept {
+  detail::fp_many_result r = detail::parse_fp_double_many(first, last, delimiter, out, cap);
+  return {r.ptr, r.count, static_cast<errc>(r.ec)};
+}
+
+inline from_chars_many_result from_chars_many(const char* first, const char* last, char delimiter, float* out,
+                                              detail::usize cap) noexcept {
+  detail::fp_many_result r = detail::parse_fp_float_many(first, last, delimiter, out, cap);
+  return {r.ptr, r.count, static_cast<errc>(r.ec)};
+}
+
+// Shortest round-trip formatting: the fewest significant digits that parse back to the same
+// value, in plain or scientific notation, whichever is shorter ("0.001", "1e+22", "-inf").
+// Output matches std::to_chars(first, last, value). Nothing is NUL-terminated; 24 bytes (double)
+// or 15 bytes (float) are always enough.
+//   - ok: ptr is one past the last character written.
+//   - value_too_large: ptr is `last`; the contents of [first, last) are unspecified.
+
+struct to_chars_result {
+  char* ptr;
+  errc ec;
+};
+
+inline to_chars_result to_chars(char* first, char* last, double value) noexcept {
+  detail::fp_to_chars_result r = detail::format_double(first, last, value);
+  return {r.ptr, static_cast<errc>(r.ec)};
+}
+
+inline to_chars_result to_chars(char* first, char* last, float value) noexcept {
+  detail::fp_to_chars_result r = detail::format_float(first, last, value);
+  return {r.ptr, static_cast<errc>(r.ec)};
 }
 
 // Whitespace-skipping variants (ASCII only).
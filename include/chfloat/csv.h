@@ -0,0 +1,473 @@
+#pragma once
+
+// chfloat/csv.h: column-oriented CSV ingestion into per-column arrays.
+// Optional add-on to chfloat.h; like stream.h it uses <cstdio> and allocates its buffers.
+//
+//   const chfloat::column_type schema[] = {chfloat::column_type::i64, chfloat::column_type::skip,
+//                                          chfloat::column_type::f64};
+//   chfloat::csv_reader r("prices.csv", schema, 3);
+//   while (r.next() == chfloat::errc::ok && r.rows() != 0) consume(r.columns()[2].f64.data(), r.rows());
+//
+// Rows are parsed in one pass, in place, straight into one contiguous array per column; no
+// field is ever copied into a std::string. Numeric fields go through chfloat::from_chars, and
+// the ends of skipped and quoted fields are found by a 16-byte SIMD scan for the delimiter,
+// newline and quote bytes.
+//
+// Grammar: rows end in "\n" or "\r\n" (the last one may end at the end of input); empty lines
+// are skipped. A field may be quoted ("a,b", with "" for a quote). Numeric fields may be
+// quoted and surrounded by spaces or tabs, but must not be empty.
+
+#include <chfloat/chfloat.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace chfloat {
+
+enum class column_type : unsigned char {
+  skip, // parsed over, not stored
+  f64,  // double
+  f32,  // float
+  i64,  // long long, base 10
+};
+
+// One output column; only the array matching `type` is filled.
+struct csv_column {
+  column_type type = column_type::skip;
+  std::vector<double> f64;
+  std::vector<float> f32;
+  std::vector<long long> i64;
+};
+
+struct csv_options {
+  char delimiter = ',';
+  char quote = '"';
+  bool header = false; // skip the first row
+  // Bytes read per chunk by csv_reader. A row longer than this grows the buffer.
+  detail::usize chunk_size = detail::usize(1) << 20;
+};
+
+namespace detail {
+
+inline const char* csv_find(const char* p, const char* last, char a, char b) noexcept {
+  // First byte in [p, last) equal to a or b (or last).
+#if CHFLOAT_SIMD_SSE2
+  const __m128i va = _mm_set1_epi8(a);
+  const __m128i vb = _mm_set1_epi8(b);
+  while ((last - p) >= 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const u32 m = static_cast<u32>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb))));
+    if (m != 0) return p + tz32(m);
+    p += 16;
+  }
+#elif CHFLOAT_SIMD_NEON
+  const uint8x16_t va = vdupq_n_u8(static_cast<unsigned char>(a));
+  const uint8x16_t vb = vdupq_n_u8(static_cast<unsigned char>(b));
+  while ((last - p) >= 16) {
+    const uint8x16_t v = vld1q_u8(reinterpret_cast<const unsigned char*>(p));
+    const u32 m = neon_movemask(vorrq_u8(vceqq_u8(v, va), vceqq_u8(v, vb)));
+    if (m != 0) return p + tz32(m);
+    p += 16;
+  }
+#endif
+  while (p < last && *p != a && *p != b) ++p;
+  return p;
+}
+
+inline const char* csv_skip_blanks(const char* p, const char* last, char delimiter) noexcept {
+  while (p < last && (*p == ' ' || *p == '\t') && *p != delimiter) ++p;
+  return p;
+}
+
+// Where the column values of one call go: base pointers indexed by row.
+struct csv_sink {
+  column_type type;
+  void* out;
+};
+
+struct csv_rows_result {
+  const char* ptr; // end of the last complete row; on error the start of the offending field
+  usize rows;
+  errc ec;
+  bool need_more; // stopped at a row cut by `last` (only when !eof); ptr is its start
+};
+
+enum csv_field_status { csv_field_ok, csv_field_error, csv_field_more };
+
+template <class T>
+inline errc csv_parse_number(const char* p, const char* last, char delimiter, T& v, const char*& end) noexcept {
+  // A value with optional blanks on both sides; end is the first byte after the blanks.
+  p = csv_skip_blanks(p, last, delimiter);
+  const from_chars_result r = chfloat::from_chars(p, last, v);
+  if (r.ptr == p) return errc::invalid_argument;
+  end = csv_skip_blanks(r.ptr, last, delimiter);
+  return r.ec;
+}
+
+inline errc csv_store(const csv_sink& s, usize row, const char* p, const char* last, char delimiter,
+                      const char*& end) noexcept {
+  switch (s.type) {
+    case column_type::f64:
+      return csv_parse_number(p, last, delimiter, static_cast<double*>(s.out)[row], end);
+    case column_type::f32:
+      return csv_parse_number(p, last, delimiter, static_cast<float*>(s.out)[row], end);
+    case column_type::i64:
+      return csv_parse_number(p, last, delimiter, static_cast<long long*>(s.out)[row], end);
+    default:
+      return errc::invalid_argument;
+  }
+}
+
+inline csv_field_status csv_field(const csv_sink& s, usize row, const char*& p, const char* last, bool eof,
+                                  const csv_options& opt, errc& ec) noexcept {
+  // Parses one field at p and leaves p on the byte that ends it (delimiter, newline, or last).
+  // On csv_field_error, ec says why: invalid_argument, or result_out_of_range for a value
+  // that does not fit its column.
+  const char d = opt.delimiter;
+  if (p < last && *p == opt.quote) {
+    const char* const content = p + 1;
+    const char* q = content;
+    bool escaped = false;
+    for (;;) {
+      const char* e = csv_find(q, last, opt.quote, opt.quote);
+      if (e == last || (e + 1 == last && !eof)) {
+        ec = errc::invalid_argument; // unterminated quote
+        return eof ? csv_field_error : csv_field_more;
+      }
+      if (e + 1 < last && e[1] == opt.quote) {
+        escaped = true;
+        q = e + 2;
+        continue;
+      }
+      q = e;
+      break;
+    }
+    if (s.type != column_type::skip) {
+      const char* end = nullptr;
+      ec = escaped ? errc::invalid_argument : csv_store(s, row, content, q, d, end);
+      if (ec == errc::ok && end != q) ec = errc::invalid_argument;
+      if (ec != errc::ok) return csv_field_error;
+    }
+    p = csv_skip_blanks(q + 1, last, d);
+    return csv_field_ok;
+  }
+
+  if (s.type == column_type::skip) {
+    p = csv_find(p, last, d, '\n');
+    return (p == last && !eof) ? csv_field_more : csv_field_ok;
+  }
+  const char* end = p;
+  ec = csv_store(s, row, p, last, d, end);
+  if (ec != errc::ok) return csv_field_error;
+  if (end == last && !eof) return csv_field_more;
+  p = end;
+  return csv_field_ok;
+}
+
+inline csv_rows_result csv_fail(const char* row, const char* field, const char* last, usize rows, errc ec,
+                                bool eof) noexcept {
+  // A field cut by the end of the chunk can look malformed ("1e" of "1e5", "-" of "-2"), so
+  // before eof an error only counts once the rest of the row is in [field, last).
+  if (!eof && csv_find(field, last, '\n', '\n') == last) return {row, rows, errc::ok, true};
+  return {field, rows, ec, false};
+}
+
+// Parses whole rows from [p, last) into row indices [0, max_rows) of the sinks. With eof the
+// input ends at `last`; otherwise a row cut by `last` is left for the next call (need_more).
+inline csv_rows_result parse_csv_rows(const char* p, const char* last, bool eof, const csv_sink* cols,
+                                      usize ncols, usize max_rows, const csv_options& opt) noexcept {
+  usize rows = 0;
+  for (;;) {
+    const char* const row = p;
+    if (p == last) return {p, rows, errc::ok, false};
+    if (*p == '\n') {
+      ++p;
+      continue;
+    }
+    if (*p == '\r') {
+      if (p + 1 == last) return {eof ? last : row, rows, errc::ok, !eof};
+      if (p[1] == '\n') {
+        p += 2;
+        continue;
+      }
+    }
+    if (rows == max_rows) return {row, rows, errc::ok, false};
+
+    for (usize c = 0; c < ncols; ++c) {
+      const char* const field = p;
+      errc ec = errc::ok;
+      const csv_field_status st = csv_field(cols[c], rows, p, last, eof, opt, ec);
+      if (st == csv_field_more) return {row, rows, errc::ok, true};
+      if (st == csv_field_error) return csv_fail(row, field, last, rows, ec, eof);
+
+      if (c + 1 < ncols) {
+        if (p < last && *p == opt.delimiter) {
+          ++p;
+          continue;
+        }
+        if (p == last && !eof) return {row, rows, errc::ok, true};
+        return csv_fail(row, field, last, rows, errc::invalid_argument, eof); // garbage or too few fields
+      }
+      if (p == last) {
+        if (!eof) return {row, rows, errc::ok, true};
+      } else if (*p == '\n') {
+        ++p;
+      } else if (*p == '\r' && p + 1 < last && p[1] == '\n') {
+        p += 2;
+      } else if (*p == '\r' && p + 1 == last) {
+        if (!eof) return {row, rows, errc::ok, true};
+        ++p;
+      } else {
+        return csv_fail(row, field, last, rows, errc::invalid_argument, eof); // garbage or too many fields
+      }
+    }
+    ++rows;
+  }
+}
+
+inline void csv_init_columns(std::vector<csv_column>& cols, const column_type* schema, usize ncols) {
+  cols.resize(ncols);
+  for (usize c = 0; c < ncols; ++c) cols[c].type = schema[c];
+}
+
+inline void csv_reserve_rows(std::vector<csv_column>& cols, std::vector<csv_sink>& sinks, usize base,
+                             usize max_rows) {
+  // Room for max_rows more values per stored column, written from index base on.
+  sinks.resize(cols.size());
+  for (usize c = 0; c < cols.size(); ++c) {
+    csv_column& col = cols[c];
+    sinks[c].type = col.type;
+    sinks[c].out = nullptr;
+    switch (col.type) {
+      case column_type::f64:
+        col.f64.resize(base + max_rows);
+        sinks[c].out = col.f64.data() + base;
+        break;
+      case column_type::f32:
+        col.f32.resize(base + max_rows);
+        sinks[c].out = col.f32.data() + base;
+        break;
+      case column_type::i64:
+        col.i64.resize(base + max_rows);
+        sinks[c].out = col.i64.data() + base;
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+inline void csv_trim_rows(std::vector<csv_column>& cols, usize rows) {
+  for (csv_column& col : cols) {
+    if (col.type == column_type::f64) col.f64.resize(rows);
+    if (col.type == column_type::f32) col.f32.resize(rows);
+    if (col.type == column_type::i64) col.i64.resize(rows);
+  }
+}
+
+inline usize csv_max_rows(const char* p, const char* last) noexcept {
+  // Every row but the last ends in '\n', so newlines + 1 bounds the row count (newlines inside
+  // quoted fields only loosen it). Sizing the columns by this count keeps the zero-fill of the
+  // output arrays proportional to the rows actually present.
+  usize n = 1;
+#if CHFLOAT_SIMD_SSE2
+  const __m128i nl = _mm_set1_epi8('\n');
+  while ((last - p) >= 16) {
+    // Byte counters (0 - matches) for up to 255 blocks, then summed by _mm_sad_epu8.
+    __m128i acc = _mm_setzero_si128();
+    for (int i = 0; i < 255 && (last - p) >= 16; ++i, p += 16) {
+      acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), nl));
+    }
+    const __m128i sum = _mm_sad_epu8(acc, _mm_setzero_si128());
+    n += static_cast<usize>(_mm_cvtsi128_si32(sum)) + static_cast<usize>(_mm_extract_epi16(sum, 4));
+  }
+#elif CHFLOAT_SIMD_NEON
+  const uint8x16_t nl = vdupq_n_u8('\n');
+  while ((last - p) >= 16) {
+    uint8x16_t acc = vdupq_n_u8(0);
+    for (int i = 0; i < 255 && (last - p) >= 16; ++i, p += 16) {
+      acc = vsubq_u8(acc, vceqq_u8(vld1q_u8(reinterpret_cast<const unsigned char*>(p)), nl));
+    }
+    n += static_cast<usize>(vaddlvq_u8(acc));
+  }
+#endif
+  for (; p < last; ++p) n += (*p == '\n');
+  return n;
+}
+
+inline const char* csv_skip_header(const char* p, const char* last, bool eof, usize ncols,
+                                   const csv_options& opt, errc& ec) {
+  // Skips the first row with every column treated as skip. nullptr: the row is not complete
+  // in [p, last) yet (only when !eof).
+  std::vector<csv_sink> skip(ncols, csv_sink{column_type::skip, nullptr});
+  const csv_rows_result r = parse_csv_rows(p, last, eof, skip.data(), ncols, 1, opt);
+  ec = r.ec;
+  if (r.need_more || (ec == errc::ok && r.rows == 0 && !eof)) return nullptr;
+  return r.ptr;
+}
+
+} // namespace detail
+
+// Parses all rows of the in-memory CSV text [first, last) and appends them to `out` (one
+// csv_column per schema entry; `out` is set up from the schema when it is empty).
+//   - ok: ptr is last; count is the number of rows appended.
+//   - error: ptr is the start of the offending field; the rows before its row are appended.
+// Fewer or more fields than schema columns, or a malformed numeric field, is invalid_argument;
+// a number outside its column's range (as from_chars reports it) is result_out_of_range.
+inline from_chars_many_result parse_csv(const char* first, const char* last, const column_type* schema,
+                                        detail::usize ncols, std::vector<csv_column>& out,
+                                        const csv_options& opt = csv_options()) {
+  using detail::usize;
+  if (ncols == 0) return {first, 0, errc::invalid_argument};
+  if (out.empty()) detail::csv_init_columns(out, schema, ncols);
+  if (out.size() != ncols) return {first, 0, errc::invalid_argument};
+
+  const char* p = first;
+  if (opt.header) {
+    errc ec = errc::ok;
+    p = detail::csv_skip_header(p, last, true, ncols, opt, ec);
+    if (ec != errc::ok) return {p, 0, ec};
+  }
+
+  usize base = 0;
+  for (const csv_column& col : out) {
+    if (col.type == column_type::f64) base = col.f64.size();
+    if (col.type == column_type::f32) base = col.f32.size();
+    if (col.type == column_type::i64) base = col.i64.size();
+  }
+  const usize max_rows = detail::csv_max_rows(p, last);
+  std::vector<detail::csv_sink> sinks;
+  detail::csv_reserve_rows(out, sinks, base, max_rows);
+  const detail::csv_rows_result r = detail::parse_csv_rows(p, last, true, sinks.data(), ncols, max_rows, opt);
+  detail::csv_trim_rows(out, base + r.rows);
+  return {r.ptr, r.rows, r.ec};
+}
+
+// Chunked CSV file reader: next() parses the rows of the next chunk into columns(), one array
+// per schema entry, valid until the following call. Rows cut by a chunk boundary are carried
+// over to the next read.
+class csv_reader {
+ public:
+  csv_reader(const char* path, const column_type* schema, detail::usize ncols, csv_options opt = csv_options())
+      : file_(std::fopen(path, "rb")), owns_file_(true), opt_(opt) {
+    init(schema, ncols);
+  }
+
+  // Reads from an already open stream; the caller keeps ownership of `file`.
+  csv_reader(std::FILE* file, const column_type* schema, detail::usize ncols, csv_options opt = csv_options())
+      : file_(file), owns_file_(false), opt_(opt) {
+    init(schema, ncols);
+  }
+
+  csv_reader(const csv_reader&) = delete;
+  csv_reader& operator=(const csv_reader&) = delete;
+
+  ~csv_reader() {
+    if (owns_file_ && file_ != nullptr) std::fclose(file_);
+  }
+
+  bool is_open() const noexcept { return file_ != nullptr; }
+
+  // Parses the next chunk of rows into columns()[c] [0, rows()).
+  //   - ok with rows() == 0: end of input.
+  //   - error: error_offset() is the byte offset of the offending field (or of the read
+  //     position for an unopened file / read error, reported as invalid_argument). The rows
+  //     before it in this chunk are still in columns(); later calls keep failing.
+  errc next() {
+    rows_ = 0;
+    detail::csv_trim_rows(cols_, 0);
+    if (ec_ != errc::ok || done_) return ec_;
+    if (file_ == nullptr || cols_.empty()) return fail(errc::invalid_argument, offset_);
+
+    // Read until at least one complete row (or the end of input) is in the buffer.
+    usize have = carry_;
+    for (;;) {
+      if (buf_.size() - have < chunk_size_) buf_.resize(have + chunk_size_);
+      const usize got = std::fread(buf_.data() + have, 1, buf_.size() - have, file_);
+      bool eof = false;
+      if (got < buf_.size() - have) {
+        if (std::ferror(file_)) return fail(errc::invalid_argument, offset_ + have);
+        eof = true;
+      }
+      have += got;
+
+      const char* const first = buf_.data();
+      const char* last = first + have;
+      const char* p = first;
+      if (header_pending_) {
+        errc ec = errc::ok;
+        p = detail::csv_skip_header(first, last, eof, cols_.size(), opt_, ec);
+        if (p == nullptr) continue; // the header row is longer than a chunk
+        if (ec != errc::ok) return fail(ec, offset_ + static_cast<usize>(p - first));
+        header_pending_ = false;
+        const usize used = static_cast<usize>(p - first);
+        std::memmove(buf_.data(), buf_.data() + used, have - used);
+        have -= used;
+        offset_ += used;
+        last = first + have;
+        p = first;
+      }
+
+      const usize max_rows = detail::csv_max_rows(p, last);
+      detail::csv_reserve_rows(cols_, sinks_, 0, max_rows);
+      const detail::csv_rows_result r =
+          detail::parse_csv_rows(p, last, eof, sinks_.data(), cols_.size(), max_rows, opt_);
+      rows_ = r.rows;
+      detail::csv_trim_rows(cols_, rows_);
+      if (r.ec != errc::ok) return fail(r.ec, offset_ + static_cast<usize>(r.ptr - first));
+      if (eof) done_ = true;
+
+      const usize used = static_cast<usize>(r.ptr - first);
+      if (rows_ == 0 && !eof) {
+        // Only blank lines so far, or a row longer than the chunk: read more.
+        if (used == have) {
+          offset_ += have;
+          have = 0;
+        }
+        continue;
+      }
+      // Carry the cut row (if any) to the front of the buffer.
+      carry_ = have - used;
+      std::memmove(buf_.data(), buf_.data() + used, carry_);
+      offset_ += used;
+      return errc::ok;
+    }
+  }
+
+  const std::vector<csv_column>& columns() const noexcept { return cols_; }
+  detail::usize rows() const noexcept { return rows_; }
+  unsigned long long error_offset() const noexcept { return error_offset_; }
+
+ private:
+  using usize = detail::usize;
+
+  void init(const column_type* schema, usize ncols) {
+    detail::csv_init_columns(cols_, schema, ncols);
+    chunk_size_ = (opt_.chunk_size != 0) ? opt_.chunk_size : 1;
+    header_pending_ = opt_.header;
+  }
+
+  errc fail(errc ec, unsigned long long offset) noexcept {
+    ec_ = ec;
+    error_offset_ = offset;
+    return ec;
+  }
+
+  std::FILE* file_;
+  bool owns_file_;
+  csv_options opt_;
+  usize chunk_size_ = 0;
+  std::vector<char> buf_;
+  std::vector<csv_column> cols_;
+  std::vector<detail::csv_sink> sinks_;
+  usize rows_ = 0;
+  usize carry_ = 0;
+  unsigned long long offset_ = 0; // file offset of buf_[0]
+  unsigned long long error_offset_ = 0;
+  errc ec_ = errc::ok;
+  bool done_ = false;
+  bool header_pending_ = false;
+};
+
+} // namespace chfloat
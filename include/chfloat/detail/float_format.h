@@ -0,0 +1,376 @@
+#pragma once
+#ifndef CHFLOAT_FLOAT_FORMAT_HPP
+#define CHFLOAT_FLOAT_FORMAT_HPP
+// Internal floating-point formatting implementation (shortest round-trip output).
+//
+// Exposes:
+//   chfloat::detail::fp_to_chars_result
+//   chfloat::detail::format_double
+//   chfloat::detail::format_float
+//
+// The digits come from Schubfach (R. Giulietti, "The Schubfach way to render doubles"): the
+// rounding interval of the input is scaled by an upper approximation of 10^-k (128-bit for
+// binary64, 64-bit for binary32) with round-to-odd products, and the shortest decimal inside
+// it is found with at most two candidate checks. The powers come from pow5_table.
+//
+// The text matches std::to_chars without a format argument: plain or scientific notation,
+// whichever is shorter (plain on ties), and "inf" / "nan" with an optional '-'.
+
+#include <chfloat/detail/float_parse.h>
+
+namespace chfloat {
+namespace detail {
+
+struct fp_to_chars_result {
+  char* ptr;
+  int ec;
+};
+
+static inline u64 double_to_bits(double d) noexcept {
+  union {
+    double d;
+    u64 u;
+  } v;
+  v.d = d;
+  return v.u;
+}
+
+static inline u32 float_to_bits(float f) noexcept {
+  union {
+    float f;
+    u32 u;
+  } v;
+  v.f = f;
+  return v.u;
+}
+
+// floor(log10(2^e)), floor(log10(3/4 * 2^e)) and floor(log2(10^e)), exact for |e| <= 1650.
+static inline i32 floor_log10_pow2(i32 e) noexcept { return (e * 1262611) >> 22; }
+static inline i32 floor_log10_three_quarters_pow2(i32 e) noexcept { return (e * 1262611 - 524031) >> 22; }
+static inline i32 floor_log2_pow10(i32 e) noexcept { return (e * 1741647) >> 19; }
+
+static inline u128 pow10_upper_128(i32 k) noexcept {
+  // floor(10^k * 2^-r) + 1, normalized to [2^127, 2^128); 10^k and 5^k share that mantissa.
+  // The table truncates every entry except q in [-27, -1], which are already rounded up.
+  // Preconditions: -292 <= k <= 324.
+  const pow5_128 c = pow5_entry(k);
+  if (k >= -27 && k < 0) return {c.hi, c.lo};
+  const u64 lo = c.lo + 1ULL;
+  return {c.hi + ((lo == 0) ? 1ULL : 0ULL), lo};
+}
+
+static inline u64 pow10_upper_64(i32 k) noexcept {
+  // Same, normalized to [2^63, 2^64). The high half of a truncated entry is the truncated
+  // 64-bit value, and for q in [-27, -1] rounding up at bit 0 never carries into it.
+  // Preconditions: -31 <= k <= 45.
+  return pow5_entry(k).hi + 1ULL;
+}
+
+static inline u64 round_to_odd_128(u128 g, u64 cp) noexcept {
+  // floor(g * cp / 2^128), with bit 0 set when the discarded part is not zero.
+  const u128 x = mul_64x64_to_128(g.lo, cp);
+  const u128 y = mul_64x64_to_128(g.hi, cp);
+  const u64 z = y.lo + x.hi;
+  const u64 y1 = y.hi + ((z < y.lo) ? 1ULL : 0ULL);
+  return y1 | ((z > 1) ? 1ULL : 0ULL);
+}
+
+static inline u32 round_to_odd_64(u64 g, u32 cp) noexcept {
+  // floor(g * cp / 2^64), with bit 0 set when the discarded part is not zero.
+  const u128 p = mul_64x64_to_128(g, cp);
+  const u32 y1 = static_cast<u32>(p.hi);
+  const u32 y0 = static_cast<u32>(p.lo >> 32);
+  return y1 | ((y0 > 1) ? 1u : 0u);
+}
+
+// sig * 10^exp, the shortest decimal that rounds back to the input (sig may end in zeros).
+// The input is c * 2^q; plain notation prints large integers exactly, as printf does.
+struct shortest_decimal {
+  u64 sig;
+  i32 exp;
+  u64 c;
+  i32 q;
+};
+
+static inline shortest_decimal shortest_binary64(u64 bits) noexcept {
+  // Preconditions: bits is a finite, non-zero, positive binary64.
+  const u64 ieee_mant = bits & ((1ULL << 52) - 1ULL);
+  const u32 ieee_exp = static_cast<u32>(bits >> 52);
+  u64 c;
+  i32 q;
+  if (ieee_exp != 0) {
+    c = ieee_mant | (1ULL << 52);
+    q = static_cast<i32>(ieee_exp) - 1075;
+    // Integers below 2^53 are their own shortest decimal.
+    if (q <= 0 && q > -53 && (c & ((1ULL << -q) - 1ULL)) == 0) return {c >> -q, 0, c, q};
+  } else {
+    c = ieee_mant;
+    q = -1074;
+  }
+
+  // The interval of values rounding to c * 2^q, times 4: [cbl, cbr], ends included when c is
+  // even. At a power of two the lower neighbour is twice as close.
+  const bool even = (c & 1ULL) == 0;
+  const bool closer = (ieee_mant == 0 && ieee_exp > 1);
+  const u64 cbl = 4 * c - 2 + (closer ? 1ULL : 0ULL);
+  const u64 cb = 4 * c;
+  const u64 cbr = 4 * c + 2;
+
+  const i32 k = closer ? floor_log10_three_quarters_pow2(q) : floor_log10_pow2(q);
+  const i32 h = q + floor_log2_pow10(-k) + 1; // in [1, 4]
+  const u128 g = pow10_upper_128(-k);
+  const u64 vbl = round_to_odd_128(g, cbl << h);
+  const u64 vb = round_to_odd_128(g, cb << h);
+  const u64 vbr = round_to_odd_128(g, cbr << h);
+  const u64 lower = vbl + (even ? 0ULL : 1ULL);
+  const u64 upper = vbr - (even ? 0ULL : 1ULL);
+
+  // One digit fewer if a multiple of 10 (times 10^k) is inside, else the closer of s and s+1.
+  const u64 s = vb / 4;
+  if (s >= 10) {
+    const u64 sp = s / 10;
+    const bool up_inside = lower <= 40 * sp;
+    const bool wp_inside = 40 * sp + 40 <= upper;
+    if (up_inside != wp_inside) return {sp + (wp_inside ? 1ULL : 0ULL), k + 1, c, q};
+  }
+  const bool u_inside = lower <= 4 * s;
+  const bool w_inside = 4 * s + 4 <= upper;
+  if (u_inside != w_inside) return {s + (w_inside ? 1ULL : 0ULL), k, c, q};
+  const u64 mid = 4 * s + 2;
+  const bool round_up = vb > mid || (vb == mid && (s & 1ULL) != 0);
+  return {s + (round_up ? 1ULL : 0ULL), k, c, q};
+}
+
+static inline shortest_decimal shortest_binary32(u32 bits) noexcept {
+  // Same as shortest_binary64 with 32-bit products.
+  // Preconditions: bits is a finite, non-zero, positive binary32.
+  const u32 ieee_mant = bits & ((1u << 23) - 1u);
+  const u32 ieee_exp = bits >> 23;
+  u32 c;
+  i32 q;
+  if (ieee_exp != 0) {
+    c = ieee_mant | (1u << 23);
+    q = static_cast<i32>(ieee_exp) - 150;
+    if (q <= 0 && q > -24 && (c & ((1u << -q) - 1u)) == 0) return {c >> -q, 0, c, q};
+  } else {
+    c = ieee_mant;
+    q = -149;
+  }
+
+  const bool even = (c & 1u) == 0;
+  const bool closer = (ieee_mant == 0 && ieee_exp > 1);
+  const u32 cbl = 4 * c - 2 + (closer ? 1u : 0u);
+  const u32 cb = 4 * c;
+  const u32 cbr = 4 * c + 2;
+
+  const i32 k = closer ? floor_log10_three_quarters_pow2(q) : floor_log10_pow2(q);
+  const i32 h = q + floor_log2_pow10(-k) + 1;
+  const u64 g = pow10_upper_64(-k);
+  const u32 vbl = round_to_odd_64(g, cbl << h);
+  const u32 vb = round_to_odd_64(g, cb << h);
+  const u32 vbr = round_to_odd_64(g, cbr << h);
+  const u32 lower = vbl + (even ? 0u : 1u);
+  const u32 upper = vbr - (even ? 0u : 1u);
+
+  const u32 s = vb / 4;
+  if (s >= 10) {
+    const u32 sp = s / 10;
+    const bool up_inside = lower <= 40 * sp;
+    const bool wp_inside = 40 * sp + 40 <= upper;
+    if (up_inside != wp_inside) return {sp + (wp_inside ? 1u : 0u), k + 1, c, q};
+  }
+  const bool u_inside = lower <= 4 * s;
+  const bool w_inside = 4 * s + 4 <= upper;
+  if (u_inside != w_inside) return {s + (w_inside ? 1u : 0u), k, c, q};
+  const u32 mid = 4 * s + 2;
+  const bool round_up = vb > mid || (vb == mid && (s & 1u) != 0);
+  return {s + (round_up ? 1u : 0u), k, c, q};
+}
+
+inline constexpr char digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static inline void write_2_digits(char* p, u32 v) noexcept {
+  p[0] = digit_pairs[2 * v];
+  p[1] = digit_pairs[2 * v + 1];
+}
+
+static inline void write_8_digits(char* p, u32 v) noexcept {
+  // Exactly 8 digits, zero-padded. Preconditions: v < 10^8.
+  const u32 hi = v / 10000;
+  const u32 lo = v % 10000;
+  write_2_digits(p, hi / 100);
+  write_2_digits(p + 2, hi % 100);
+  write_2_digits(p + 4, lo / 100);
+  write_2_digits(p + 6, lo % 100);
+}
+
+static inline void write_u64_digits(char* end, u64 v) noexcept {
+  // Writes the decimal digits of v so that the last one lands at end[-1].
+  while (v >= 100000000ULL) {
+    end -= 8;
+    write_8_digits(end, static_cast<u32>(v % 100000000ULL));
+    v /= 100000000ULL;
+  }
+  u32 w = static_cast<u32>(v);
+  while (w >= 100) {
+    end -= 2;
+    write_2_digits(end, w % 100);
+    w /= 100;
+  }
+  if (w >= 10) {
+    write_2_digits(end - 2, w);
+  } else {
+    end[-1] = static_cast<char>('0' + w);
+  }
+}
+
+static inline int decimal_length(u64 v) noexcept {
+  // Number of decimal digits, from the bit length. Preconditions: v != 0.
+  const i32 t = ((64 - lz64(v)) * 1233) >> 12;
+  return t + ((v >= pow10_u64(t)) ? 1 : 0);
+}
+
+static inline void remove_trailing_zeros(u64& sig, i32& exp) noexcept {
+  // Preconditions: sig != 0.
+  while (sig % 100000000ULL == 0) {
+    sig /= 100000000ULL;
+    exp += 8;
+  }
+  if (sig % 10000 == 0) {
+    sig /= 10000;
+    exp += 4;
+  }
+  if (sig % 100 == 0) {
+    sig /= 100;
+    exp += 2;
+  }
+  if (sig % 10 == 0) {
+    sig /= 10;
+    exp += 1;
+  }
+}
+
+static inline u32 divmod_1e9(u128& x) noexcept {
+  // x /= 10^9, returning the remainder; 32-bit long division.
+  const u64 d = 1000000000ULL;
+  u64 r = 0;
+  u64 limb[4] = {x.hi >> 32, x.hi & 0xffffffffULL, x.lo >> 32, x.lo & 0xffffffffULL};
+  for (u64& l : limb) {
+    const u64 cur = (r << 32) | l;
+    l = cur / d;
+    r = cur % d;
+  }
+  x.hi = (limb[0] << 32) | limb[1];
+  x.lo = (limb[2] << 32) | limb[3];
+  return static_cast<u32>(r);
+}
+
+static inline void write_u128_digits(char* end, u128 x) noexcept {
+  // Same as write_u64_digits for a 128-bit value.
+  while (x.hi != 0) {
+    u32 r = divmod_1e9(x);
+    for (int i = 0; i < 9; ++i) {
+      *--end = static_cast<char>('0' + r % 10);
+      r /= 10;
+    }
+  }
+  write_u64_digits(end, x.lo);
+}
+
+static inline fp_to_chars_result write_token(char* first, char* last, bool neg, const char* s, int n) noexcept {
+  if (last - first < n + (neg ? 1 : 0)) return {last, fp_value_too_large};
+  if (neg) *first++ = '-';
+  for (int i = 0; i < n; ++i) *first++ = s[i];
+  return {first, fp_ok};
+}
+
+static inline fp_to_chars_result write_shortest(char* first, char* last, bool neg, shortest_decimal d) noexcept {
+  // Preconditions: d.sig != 0.
+  u64 sig = d.sig;
+  i32 exp = d.exp;
+  remove_trailing_zeros(sig, exp);
+  const int n = decimal_length(sig);
+
+  // "ddd000" / "dd.d" / "0.00ddd" versus "d.dde+XX".
+  const i32 sci_exp = exp + n - 1;
+  const i32 abs_exp = (sci_exp < 0) ? -sci_exp : sci_exp;
+  const i32 sci_len = n + ((n > 1) ? 1 : 0) + ((abs_exp >= 100) ? 5 : 4);
+  const i32 fixed_len = (exp >= 0) ? n + exp : (sci_exp >= 0) ? n + 1 : n + 1 - sci_exp;
+  const bool fixed = fixed_len <= sci_len;
+  const i32 len = ((fixed) ? fixed_len : sci_len) + (neg ? 1 : 0);
+  if (last - first < len) return {last, fp_value_too_large};
+
+  // Digits are written in place, one slot to the right where a '.' goes in front of them.
+  char* p = first;
+  if (neg) *p++ = '-';
+  if (fixed) {
+    if (exp > 0 && d.q > 0) {
+      // An integer of n + exp digits (below 10^23 here): print all of them, not the zeros.
+      const u128 x = {d.c >> (64 - d.q), d.c << d.q};
+      p += fixed_len;
+      write_u128_digits(p, x);
+    } else if (exp >= 0) {
+      write_u64_digits(p + n, sig);
+      p += n;
+      for (i32 i = 0; i < exp; ++i) *p++ = '0';
+    } else if (sci_exp >= 0) {
+      write_u64_digits(p + n + 1, sig);
+      for (i32 i = 0; i <= sci_exp; ++i) p[i] = p[i + 1];
+      p[sci_exp + 1] = '.';
+      p += n + 1;
+    } else {
+      *p++ = '0';
+      *p++ = '.';
+      for (i32 i = 1; i < -sci_exp; ++i) *p++ = '0';
+      write_u64_digits(p + n, sig);
+      p += n;
+    }
+  } else {
+    write_u64_digits(p + n + 1, sig);
+    p[0] = p[1];
+    if (n > 1) {
+      p[1] = '.';
+      p += n + 1;
+    } else {
+      p += 1;
+    }
+    *p++ = 'e';
+    *p++ = (sci_exp < 0) ? '-' : '+';
+    if (abs_exp >= 100) *p++ = static_cast<char>('0' + abs_exp / 100);
+    write_2_digits(p, static_cast<u32>(abs_exp % 100));
+    p += 2;
+  }
+  return {p, fp_ok};
+}
+
+static inline fp_to_chars_result format_double(char* first, char* last, double value) noexcept {
+  const u64 bits = double_to_bits(value);
+  const bool neg = (bits >> 63) != 0;
+  const u64 abs_bits = bits & ~(1ULL << 63);
+  if (abs_bits >= 0x7ff0000000000000ULL) {
+    return (abs_bits == 0x7ff0000000000000ULL) ? write_token(first, last, neg, "inf", 3)
+                                               : write_token(first, last, neg, "nan", 3);
+  }
+  if (abs_bits == 0) return write_token(first, last, neg, "0", 1);
+  return write_shortest(first, last, neg, shortest_binary64(abs_bits));
+}
+
+static inline fp_to_chars_result format_float(char* first, char* last, float value) noexcept {
+  const u32 bits = float_to_bits(value);
+  const bool neg = (bits >> 31) != 0;
+  const u32 abs_bits = bits & ~(1u << 31);
+  if (abs_bits >= 0x7f800000u) {
+    return (abs_bits == 0x7f800000u) ? write_token(first, last, neg, "inf", 3)
+                                     : write_token(first, last, neg, "nan", 3);
+  }
+  if (abs_bits == 0) return write_token(first, last, neg, "0", 1);
+  return write_shortest(first, last, neg, shortest_binary32(abs_bits));
+}
+
+} // namespace detail
+} // namespace chfloat
+
+#endif
@@ -4,12 +4,21 @@
 // Internal floating-point parsing implementation.
 //
 // Exposes:
-//   chfloat::detail::fp_chars_result
+//   chfloat::detail::fp_chars_result (basic_fp_chars_result<CharT>)
 //   chfloat::detail::parse_fp_double
 //   chfloat::detail::parse_fp_float
+//     (Padded = true: the caller guarantees fp_padding readable bytes past `last`)
+//   chfloat::detail::parse_fp_double_many / parse_fp_float_many (parse_fp_sep_many: either, by type)
+//   chfloat::detail::parse_fp_hex_double / parse_fp_hex_float
+//   chfloat::detail::parse_scaled_i64
+//   chfloat::detail::parse_fp_json
+//   chfloat::detail::validate_fp
+// The decimal, hex and JSON parsers are constexpr under CHFLOAT_HAS_CONSTEXPR_FROM_CHARS (below).
+// They also take char16_t / char32_t / wchar_t input in place (CharT is deduced from the
+// pointers): wider code units are narrowed to bytes only inside the digit classifiers.
 //
 // Error codes match chfloat::errc ordinal values:
-//   0 = ok, 1 = invalid_argument, 2 = result_out_of_range
+//   0 = ok, 1 = invalid_argument, 2 = result_out_of_range, 3 = value_too_large
 
 #include <chfloat/detail/pow5_table.h>
 
@@ -17,6 +26,79 @@
   #include <intrin.h>
 #endif
 
+// The parser is split into small helpers; the hot ones must still collapse into one function body.
+#if defined(_MSC_VER)
+  #define CHFLOAT_FORCE_INLINE __forceinline
+#elif defined(__GNUC__) || defined(__clang__)
+  #define CHFLOAT_FORCE_INLINE inline __attribute__((always_inline))
+#else
+  #define CHFLOAT_FORCE_INLINE inline
+#endif
+
+// C++20 on compilers with __builtin_is_constant_evaluated and __builtin_bit_cast (GCC 11,
+// Clang 9, MSVC 19.28): the decimal and hex parsers are constexpr, so chfloat::from_chars can
+// run at compile time. Constant evaluation takes the portable code; intrinsics and SIMD stay
+// on the runtime path.
+#if (__cplusplus >= 202002L) || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+  #if defined(_MSC_VER) && !defined(__clang__)
+    #if _MSC_VER >= 1928
+      #define CHFLOAT_HAS_CONSTEXPR_FROM_CHARS 1
+    #endif
+  #elif defined(__has_builtin)
+    #if __has_builtin(__builtin_is_constant_evaluated) && __has_builtin(__builtin_bit_cast)
+      #define CHFLOAT_HAS_CONSTEXPR_FROM_CHARS 1
+    #endif
+  #endif
+#endif
+#ifndef CHFLOAT_HAS_CONSTEXPR_FROM_CHARS
+  #define CHFLOAT_HAS_CONSTEXPR_FROM_CHARS 0
+#endif
+#if CHFLOAT_HAS_CONSTEXPR_FROM_CHARS
+  #define CHFLOAT_CONSTEXPR20 constexpr
+#else
+  #define CHFLOAT_CONSTEXPR20
+#endif
+
+// Compile-time selected SIMD kernels for digit scanning. Define CHFLOAT_NO_SIMD to force the
+// portable SWAR/scalar path.
+#if !defined(CHFLOAT_NO_SIMD)
+  #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CHFLOAT_SIMD_SSE2 1
+    #include <emmintrin.h>
+  #endif
+  #if defined(__AVX2__)
+    #define CHFLOAT_SIMD_AVX2 1
+    #include <immintrin.h>
+  #endif
+  #if !defined(CHFLOAT_SIMD_SSE2) && (defined(__aarch64__) || defined(_M_ARM64))
+    #define CHFLOAT_SIMD_NEON 1
+    #include <arm_neon.h>
+  #endif
+#endif
+#ifndef CHFLOAT_SIMD_SSE2
+  #define CHFLOAT_SIMD_SSE2 0
+#endif
+#ifndef CHFLOAT_SIMD_AVX2
+  #define CHFLOAT_SIMD_AVX2 0
+#endif
+#ifndef CHFLOAT_SIMD_NEON
+  #define CHFLOAT_SIMD_NEON 0
+#endif
+
+// Runtime-selected kernels (CHFLOAT_RUNTIME_DISPATCH, CMake option of the same name): x86-64
+// builds that do not already target AVX2 + BMI2 also carry an AVX2/BMI2 copy of the long
+// digit-run scan and of the batch parsers, picked from CPUID once per process. GCC/Clang only;
+// elsewhere the option is accepted and the compile-time kernels are used.
+#if defined(CHFLOAT_RUNTIME_DISPATCH) && !defined(CHFLOAT_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && \
+    defined(__x86_64__) && !(defined(__AVX2__) && defined(__BMI2__))
+  #define CHFLOAT_DISPATCH_X86 1
+  #include <immintrin.h>
+  #define CHFLOAT_TARGET_AVX2 __attribute__((target("avx2,bmi,bmi2")))
+#endif
+#ifndef CHFLOAT_DISPATCH_X86
+  #define CHFLOAT_DISPATCH_X86 0
+#endif
+
 namespace chfloat {
 namespace detail {
 
@@ -24,39 +106,121 @@ using u64 = unsigned long long;
 using u32 = unsigned int;
 using i32 = int;
 using i64 = long long;
+using usize = decltype(sizeof(0));
 
 enum fp_ec : int {
   fp_ok = 0,
   fp_invalid_argument = 1,
   fp_result_out_of_range = 2,
+  fp_value_too_large = 3,
 };
 
-struct fp_chars_result {
-  const char* ptr;
+// Number grammars; values match chfloat::chars_format.
+//   general: optional exponent, fixed: no exponent (parsing stops before 'e'),
+//   scientific: the exponent is required, hex: %a-style (see parse_hex_bits),
+//   json: RFC 8259 numbers, i.e. -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?, no nan/inf.
+// Readable bytes past `last` that the Padded parsers rely on: every load then stays within
+// last + fp_padding, so no loop falls back to byte-at-a-time reads for the end of the input.
+inline constexpr usize fp_padding = 32;
+
+enum fp_fmt : int {
+  fp_fmt_general = 0,
+  fp_fmt_scientific = 1,
+  fp_fmt_fixed = 2,
+  fp_fmt_hex = 3,
+  fp_fmt_json = 4,
+};
+
+template <class CharT>
+struct basic_fp_chars_result {
+  const CharT* ptr;
   int ec;
 };
 
+using fp_chars_result = basic_fp_chars_result<char>;
+
 struct u128 {
   u64 hi;
   u64 lo;
 };
 
-static inline u64 load_u64_unaligned(const char* p) noexcept {
+static constexpr inline bool is_constant_evaluated() noexcept {
+#if CHFLOAT_HAS_CONSTEXPR_FROM_CHARS
+  return __builtin_is_constant_evaluated();
+#else
+  return false;
+#endif
+}
+
+static CHFLOAT_CONSTEXPR20 inline u64 load_u64_unaligned(const char* p) noexcept {
+  if (!is_constant_evaluated()) {
 #if defined(_MSC_VER)
-  return *reinterpret_cast<const unsigned __int64 __unaligned*>(p);
+    return *reinterpret_cast<const unsigned __int64 __unaligned*>(p);
 #elif defined(__GNUC__) || defined(__clang__)
-  u64 v;
-  __builtin_memcpy(&v, p, 8);
-  return v;
-#else
+    // SWAR helpers expect p[0] in the low byte, as the portable fallback below produces.
+    u64 v;
+    __builtin_memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+#endif
+  }
   u64 v = 0;
-  const unsigned char* s = reinterpret_cast<const unsigned char*>(p);
-  for (int i = 0; i < 8; ++i) v |= (u64(s[i]) << (8 * i));
+  for (int i = 0; i < 8; ++i) v |= (u64(static_cast<unsigned char>(p[i])) << (8 * i));
   return v;
+}
+
+// Value of one code unit: char reads as unsigned char, wider units as they are (a negative
+// wchar_t becomes a huge value), so that no non-ASCII unit compares equal to an ASCII one.
+template <class CharT>
+static constexpr inline u32 code_unit(CharT c) noexcept {
+  if constexpr (sizeof(CharT) == 1) {
+    return static_cast<unsigned char>(c);
+  } else {
+    return static_cast<u32>(c);
+  }
+}
+
+// Eight code units as the bytes of a word (p[0] in the low byte), for the SWAR helpers below.
+// Units above 0xff saturate to 0xff (SSE2 narrows as signed, so units with the top bit set
+// become 0): neither is a digit, '.', a sign or an exponent marker, so every classification
+// matches that of the units themselves.
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 inline u64 load_8_units(const CharT* p) noexcept {
+  if constexpr (sizeof(CharT) == 1) {
+    return load_u64_unaligned(p);
+  } else {
+    if (!is_constant_evaluated()) {
+#if CHFLOAT_SIMD_SSE2
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      if constexpr (sizeof(CharT) == 4) {
+        v = _mm_packs_epi32(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 4)));
+      }
+      u64 w;
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(&w), _mm_packus_epi16(v, v));
+      return w;
+#elif CHFLOAT_SIMD_NEON
+      uint16x8_t v;
+      if constexpr (sizeof(CharT) == 2) {
+        v = vld1q_u16(reinterpret_cast<const uint16_t*>(p));
+      } else {
+        const uint32_t* q = reinterpret_cast<const uint32_t*>(p);
+        v = vcombine_u16(vqmovn_u32(vld1q_u32(q)), vqmovn_u32(vld1q_u32(q + 4)));
+      }
+      return vget_lane_u64(vreinterpret_u64_u8(vqmovn_u16(v)), 0);
 #endif
+    }
+    u64 v = 0;
+    for (int i = 0; i < 8; ++i) {
+      const u32 c = code_unit(p[i]);
+      v |= u64(c < 0x100 ? c : 0xff) << (8 * i);
+    }
+    return v;
+  }
 }
 
-static inline bool all_8_digits(u64 x) noexcept {
+static CHFLOAT_CONSTEXPR20 inline bool all_8_digits(u64 x) noexcept {
   // Each byte must be in ['0','9'].
   // For each byte b:
   //   (b - '0') underflows => high bit set
@@ -66,38 +230,72 @@ static inline bool all_8_digits(u64 x) noexcept {
   return ((a | b) & 0x8080808080808080ULL) == 0;
 }
 
-static inline bool any_nonzero_digit_8(u64 x) noexcept {
+static CHFLOAT_CONSTEXPR20 inline bool any_nonzero_digit_8(u64 x) noexcept {
   // Assumes all_8_digits(x) is true.
   return x != 0x3030303030303030ULL;
 }
 
-static inline int lz64(u64 x) noexcept {
+static CHFLOAT_CONSTEXPR20 inline u32 eight_digits_to_u32(u64 x) noexcept {
+  // Converts 8 ASCII digits (p[0] in the low byte) to their value with three multiplies.
+  // Assumes all_8_digits(x) is true.
+  x -= 0x3030303030303030ULL;
+  x = (x * 10ULL) + (x >> 8); // pairs: each even byte now holds a 2-digit value
+  const u64 mask = 0x000000ff000000ffULL;
+  const u64 mul1 = 100ULL + (1000000ULL << 32);
+  const u64 mul2 = 1ULL + (10000ULL << 32);
+  x = (((x & mask) * mul1) + (((x >> 16) & mask) * mul2)) >> 32;
+  return static_cast<u32>(x);
+}
+
+static CHFLOAT_CONSTEXPR20 inline int tz64(u64 x) noexcept {
+  // Preconditions: x != 0.
+#if defined(_MSC_VER) && defined(_M_X64)
+  if (!is_constant_evaluated()) {
+    unsigned long idx;
+    _BitScanForward64(&idx, x);
+    return int(idx);
+  }
+#elif defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(x);
+#endif
+  int n = 0;
+  while ((x & 1ULL) == 0) {
+    ++n;
+    x >>= 1;
+  }
+  return n;
+}
+
+static CHFLOAT_CONSTEXPR20 inline int lz64(u64 x) noexcept {
   if (x == 0) return 64;
 #if defined(_MSC_VER) && defined(_M_X64)
-  unsigned long idx;
-  _BitScanReverse64(&idx, x);
-  return int(63 - idx);
+  if (!is_constant_evaluated()) {
+    unsigned long idx;
+    _BitScanReverse64(&idx, x);
+    return int(63 - idx);
+  }
 #elif defined(__GNUC__) || defined(__clang__)
   return __builtin_clzll(x);
-#else
+#endif
   int n = 0;
   while ((x & (u64(1) << 63)) == 0) {
     ++n;
     x <<= 1;
   }
   return n;
-#endif
 }
 
-static inline u128 mul_64x64_to_128(u64 a, u64 b) noexcept {
+static CHFLOAT_CONSTEXPR20 inline u128 mul_64x64_to_128(u64 a, u64 b) noexcept {
 #if defined(_MSC_VER) && defined(_M_X64)
-  u64 hi;
-  u64 lo = _umul128(a, b, &hi);
-  return {hi, lo};
+  if (!is_constant_evaluated()) {
+    u64 hi;
+    u64 lo = _umul128(a, b, &hi);
+    return {hi, lo};
+  }
 #elif defined(__SIZEOF_INT128__)
   __uint128_t p = static_cast<__uint128_t>(a) * static_cast<__uint128_t>(b);
   return {static_cast<u64>(p >> 64), static_cast<u64>(p)};
-#else
+#endif
   const u64 a_lo = static_cast<u32>(a);
   const u64 a_hi = a >> 32;
   const u64 b_lo = static_cast<u32>(b);
@@ -112,208 +310,702 @@ static inline u128 mul_64x64_to_128(u64 a, u64 b) noexcept {
   const u64 hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
   const u64 lo = (mid << 32) | (p0 & 0xffffffffULL);
   return {hi, lo};
+}
+
+static CHFLOAT_CONSTEXPR20 inline pow5_128 pow5_entry(i32 q) noexcept {
+  // 128-bit normalized 5^q, q in [pow5_smallest_q, pow5_largest_q].
+#if defined(CHFLOAT_COMPACT_POW5)
+  // Compact table: top 128 bits of base * 5^r, plus the stored 2-bit correction.
+  const u32 i = static_cast<u32>(q - pow5_smallest_q);
+  const pow5_128& b = pow5_compact_base[i / pow5_compact_step];
+  const u32 r = i % pow5_compact_step;
+  if (r == 0) return b;
+  const u64 s = pow5_small[r];
+  const u128 lo = mul_64x64_to_128(b.lo, s);
+  const u128 hi = mul_64x64_to_128(b.hi, s);
+  const u64 x1 = hi.lo + lo.hi;
+  const u64 x2 = hi.hi + ((x1 < hi.lo) ? 1ULL : 0ULL);
+  const int l = lz64(x2); // 5 <= s < 2^63, so l is in [1, 62]
+  const u64 fix = (pow5_compact_fix[i / 32] >> (2 * (i % 32))) & 3ULL;
+  const u64 rlo = ((x1 << l) | (lo.lo >> (64 - l))) + fix;
+  const u64 rhi = ((x2 << l) | (x1 >> (64 - l))) + ((rlo < fix) ? 1ULL : 0ULL);
+  return {rhi, rlo};
+#else
+  return pow5_table[q - pow5_smallest_q];
 #endif
 }
 
 // Fixed-point approximation for log2(5^q) + q.
-static inline i32 approx_log2_pow5(i32 q) noexcept {
+static CHFLOAT_CONSTEXPR20 inline i32 approx_log2_pow5(i32 q) noexcept {
   // Uses a 16.16 fixed-point approximation to log2(5) (same numeric constant as other parsers,
   // but kept as an internal helper with different naming/structure).
   return (((152170 + 65536) * q) >> 16) + 63;
 }
 
-static inline double bits_to_double(u64 bits) noexcept {
+static CHFLOAT_CONSTEXPR20 inline double bits_to_double(u64 bits) noexcept {
+#if CHFLOAT_HAS_CONSTEXPR_FROM_CHARS
+  return __builtin_bit_cast(double, bits);
+#else
   union {
     u64 u;
     double d;
   } v;
   v.u = bits;
   return v.d;
+#endif
 }
 
-static inline float bits_to_float(u32 bits) noexcept {
+static CHFLOAT_CONSTEXPR20 inline float bits_to_float(u32 bits) noexcept {
+#if CHFLOAT_HAS_CONSTEXPR_FROM_CHARS
+  return __builtin_bit_cast(float, bits);
+#else
   union {
     u32 u;
     float f;
   } v;
   v.u = bits;
   return v.f;
+#endif
+}
+
+// Namespace scope rather than function-local statics: the latter are not allowed in constexpr
+// functions before C++23.
+inline constexpr u64 pow10_u64_table[20] = {
+    1ULL,
+    10ULL,
+    100ULL,
+    1000ULL,
+    10000ULL,
+    100000ULL,
+    1000000ULL,
+    10000000ULL,
+    100000000ULL,
+    1000000000ULL,
+    10000000000ULL,
+    100000000000ULL,
+    1000000000000ULL,
+    10000000000000ULL,
+    100000000000000ULL,
+    1000000000000000ULL,
+    10000000000000000ULL,
+    100000000000000000ULL,
+    1000000000000000000ULL,
+    10000000000000000000ULL,
+};
+
+static CHFLOAT_CONSTEXPR20 inline u64 pow10_u64(i32 e) noexcept {
+  // Preconditions: 0 <= e <= 19.
+  return pow10_u64_table[static_cast<u32>(e)];
 }
 
-static inline double pow10d_exact_upto15(i32 e) noexcept {
-  // Exact powers of 10 as integers are representable in binary64 up to 10^15 (since 10^15 < 2^53).
+// Exact powers of 10 as integers are representable in binary64 up to 10^15 (since 10^15 < 2^53).
+inline constexpr double pow10d_exact_table[16] = {
+    1.0,
+    10.0,
+    100.0,
+    1000.0,
+    10000.0,
+    100000.0,
+    1000000.0,
+    10000000.0,
+    100000000.0,
+    1000000000.0,
+    10000000000.0,
+    100000000000.0,
+    1000000000000.0,
+    10000000000000.0,
+    100000000000000.0,
+    1000000000000000.0,
+};
+
+static CHFLOAT_CONSTEXPR20 inline double pow10d_exact_upto15(i32 e) noexcept {
   // Preconditions: 0 <= e <= 15.
-  static constexpr double tbl[16] = {
-      1.0,
-      10.0,
-      100.0,
-      1000.0,
-      10000.0,
-      100000.0,
-      1000000.0,
-      10000000.0,
-      100000000.0,
-      1000000000.0,
-      10000000000.0,
-      100000000000.0,
-      1000000000000.0,
-      10000000000000.0,
-      100000000000000.0,
-      1000000000000000.0,
-  };
-  return tbl[static_cast<u32>(e)];
-}
-
-static inline double pow10d_i32(i32 e) noexcept {
-  // Small table for float-path scaling: compute in double, then cast to float.
-  // This keeps correct rounding for typical "mixed" inputs, and avoids the expensive pow5-table path.
-  // Valid for e in [-38, 38]. Call sites ensure bounds.
-  static constexpr double tbl[77] = {
-      1e-38, 1e-37, 1e-36, 1e-35, 1e-34, 1e-33, 1e-32, 1e-31, 1e-30, 1e-29, 1e-28,
-      1e-27, 1e-26, 1e-25, 1e-24, 1e-23, 1e-22, 1e-21, 1e-20, 1e-19, 1e-18, 1e-17,
-      1e-16, 1e-15, 1e-14, 1e-13, 1e-12, 1e-11, 1e-10, 1e-9,  1e-8,  1e-7,  1e-6,
-      1e-5,  1e-4,  1e-3,  1e-2,  1e-1,  1e0,   1e1,   1e2,   1e3,   1e4,   1e5,
-      1e6,   1e7,   1e8,   1e9,   1e10,  1e11,  1e12,  1e13,  1e14,  1e15,  1e16,
-      1e17,  1e18,  1e19,  1e20,  1e21,  1e22,  1e23,  1e24,  1e25,  1e26,  1e27,
-      1e28,  1e29,  1e30,  1e31,  1e32,  1e33,  1e34,  1e35,  1e36,  1e37,  1e38,
-  };
-  return tbl[static_cast<u32>(e + 38)];
-}
-
-static inline bool ascii_ieq3(const char* p, const char* lit3) noexcept {
+  return pow10d_exact_table[static_cast<u32>(e)];
+}
+
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 inline bool ascii_ieq3(const CharT* p, const char* lit3) noexcept {
   // case-insensitive compare for 3 chars
   for (int i = 0; i < 3; ++i) {
-    unsigned char a = static_cast<unsigned char>(p[i]);
+    u32 a = code_unit(p[i]);
     unsigned char b = static_cast<unsigned char>(lit3[i]);
-    if (a >= 'A' && a <= 'Z') a = static_cast<unsigned char>(a - 'A' + 'a');
+    if (a >= 'A' && a <= 'Z') a = a - 'A' + 'a';
     if (b >= 'A' && b <= 'Z') b = static_cast<unsigned char>(b - 'A' + 'a');
     if (a != b) return false;
   }
   return true;
 }
 
-static inline bool ascii_ieq8(const char* p, const char* lit8) noexcept {
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 inline bool ascii_ieq8(const CharT* p, const char* lit8) noexcept {
   for (int i = 0; i < 8; ++i) {
-    unsigned char a = static_cast<unsigned char>(p[i]);
+    u32 a = code_unit(p[i]);
     unsigned char b = static_cast<unsigned char>(lit8[i]);
-    if (a >= 'A' && a <= 'Z') a = static_cast<unsigned char>(a - 'A' + 'a');
+    if (a >= 'A' && a <= 'Z') a = a - 'A' + 'a';
     if (b >= 'A' && b <= 'Z') b = static_cast<unsigned char>(b - 'A' + 'a');
     if (a != b) return false;
   }
   return true;
 }
 
-struct dec64 {
+template <class CharT>
+struct basic_dec64 {
   u64 mant;
   i32 exp10;
   bool neg;
-  bool exact;
-  const char* ptr;
+  bool exact;      // no non-zero digit was truncated from mant
+  const CharT* ptr;
   int ec;
+  const CharT* digits; // first digit (past the sign), for re-scanning inexact inputs
+  bool integer;        // neither a '.' nor an exponent was parsed
 };
 
-static inline bool is_digit(char c) noexcept {
-  return static_cast<unsigned char>(c) >= static_cast<unsigned char>('0') &&
-         static_cast<unsigned char>(c) <= static_cast<unsigned char>('9');
+using dec64 = basic_dec64<char>;
+
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 inline bool is_digit(CharT c) noexcept {
+  return code_unit(c) >= static_cast<unsigned char>('0') && code_unit(c) <= static_cast<unsigned char>('9');
 }
 
-static inline unsigned digit_u8(unsigned char c) noexcept {
+static CHFLOAT_CONSTEXPR20 inline unsigned digit_u8(unsigned char c) noexcept {
   return static_cast<unsigned>(c) - static_cast<unsigned>('0');
 }
 
-static inline const char* scan_digits_fast(const char* p, const char* last, i32& count, bool& any_nonzero) noexcept {
-  // Scan a run of digits, counting how many and whether any digit is non-zero.
-  count = 0;
-  any_nonzero = false;
+// digit_u8 for any code unit: > 9 unless c is '0'..'9'.
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 inline unsigned digit_of(CharT c) noexcept {
+  return code_unit(c) - static_cast<unsigned>('0');
+}
+
+// Digit value of every byte for bases up to 36 ('0'-'9', 'a'-'z', 'A'-'Z'), 255 otherwise.
+struct digit_table_t {
+  unsigned char v[256];
+};
+
+static constexpr digit_table_t make_digit_table() noexcept {
+  digit_table_t t{};
+  for (int c = 0; c < 256; ++c) {
+    int dv = 255;
+    if (c >= '0' && c <= '9') dv = c - '0';
+    if (c >= 'a' && c <= 'z') dv = 10 + (c - 'a');
+    if (c >= 'A' && c <= 'Z') dv = 10 + (c - 'A');
+    t.v[c] = static_cast<unsigned char>(dv);
+  }
+  return t;
+}
+
+inline constexpr digit_table_t digit_table = make_digit_table();
+
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 inline unsigned digit_in_base36(CharT c) noexcept {
+  if constexpr (sizeof(CharT) == 1) {
+    return digit_table.v[static_cast<unsigned char>(c)];
+  } else {
+    return code_unit(c) < 0x80 ? digit_table.v[code_unit(c)] : 255u;
+  }
+}
+
+static CHFLOAT_CONSTEXPR20 inline int tz32(u32 x) noexcept {
+  // Preconditions: x != 0.
+#if defined(_MSC_VER)
+  if (!is_constant_evaluated()) {
+    unsigned long idx;
+    _BitScanForward(&idx, x);
+    return int(idx);
+  }
+#elif defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctz(x);
+#endif
+  int n = 0;
+  while ((x & 1u) == 0) {
+    ++n;
+    x >>= 1;
+  }
+  return n;
+}
+
+// 16-unit block classification. Bit i of each mask describes p[i].
+struct block_class {
+  u32 digits; // '0'..'9'
+  u32 dots;   // '.'
+  u32 exps;   // 'e' or 'E'
+};
+
+#if CHFLOAT_SIMD_SSE2
+template <class CharT>
+static inline __m128i load_16_units(const CharT* p) noexcept {
+  // 16 code units as bytes, narrowed as in load_8_units. Preconditions: 16 readable units at p.
+  const __m128i* q = reinterpret_cast<const __m128i*>(p);
+  if constexpr (sizeof(CharT) == 1) {
+    return _mm_loadu_si128(q);
+  } else if constexpr (sizeof(CharT) == 2) {
+    return _mm_packus_epi16(_mm_loadu_si128(q), _mm_loadu_si128(q + 1));
+  } else {
+    return _mm_packus_epi16(_mm_packs_epi32(_mm_loadu_si128(q), _mm_loadu_si128(q + 1)),
+                            _mm_packs_epi32(_mm_loadu_si128(q + 2), _mm_loadu_si128(q + 3)));
+  }
+}
+
+template <class CharT>
+static inline block_class classify_block16(const CharT* p) noexcept {
+  // Preconditions: 16 readable units at p.
+  const __m128i v = load_16_units(p);
+  const __m128i t = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+  // Unsigned (b - '0') <= 9  <=>  min(b - '0', 9) == b - '0'.
+  const __m128i dig = _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8(9)), t);
+  const __m128i dot = _mm_cmpeq_epi8(v, _mm_set1_epi8('.'));
+  const __m128i exq = _mm_cmpeq_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('e'));
+  return {static_cast<u32>(_mm_movemask_epi8(dig)), static_cast<u32>(_mm_movemask_epi8(dot)),
+          static_cast<u32>(_mm_movemask_epi8(exq))};
+}
+
+template <class CharT>
+static inline u32 nonzero_mask16(const CharT* p) noexcept {
+  // Bit i set when p[i] != '0'. Preconditions: 16 readable units at p.
+  const __m128i v = load_16_units(p);
+  return ~static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('0')))) & 0xffffu;
+}
+#elif CHFLOAT_SIMD_NEON
+static inline u32 neon_movemask(uint8x16_t m) noexcept {
+  // m lanes are 0x00/0xff. Collapse to one bit per lane.
+  static const unsigned char bit_tbl[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  const uint8x16_t b = vandq_u8(m, vld1q_u8(bit_tbl));
+  return static_cast<u32>(vaddv_u8(vget_low_u8(b))) | (static_cast<u32>(vaddv_u8(vget_high_u8(b))) << 8);
+}
+
+template <class CharT>
+static inline uint8x16_t load_16_units(const CharT* p) noexcept {
+  // 16 code units as bytes, narrowed as in load_8_units. Preconditions: 16 readable units at p.
+  if constexpr (sizeof(CharT) == 1) {
+    return vld1q_u8(reinterpret_cast<const unsigned char*>(p));
+  } else if constexpr (sizeof(CharT) == 2) {
+    const uint16_t* q = reinterpret_cast<const uint16_t*>(p);
+    return vcombine_u8(vqmovn_u16(vld1q_u16(q)), vqmovn_u16(vld1q_u16(q + 8)));
+  } else {
+    const uint32_t* q = reinterpret_cast<const uint32_t*>(p);
+    const uint16x8_t lo = vcombine_u16(vqmovn_u32(vld1q_u32(q)), vqmovn_u32(vld1q_u32(q + 4)));
+    const uint16x8_t hi = vcombine_u16(vqmovn_u32(vld1q_u32(q + 8)), vqmovn_u32(vld1q_u32(q + 12)));
+    return vcombine_u8(vqmovn_u16(lo), vqmovn_u16(hi));
+  }
+}
+
+template <class CharT>
+static inline block_class classify_block16(const CharT* p) noexcept {
+  // Preconditions: 16 readable units at p.
+  const uint8x16_t v = load_16_units(p);
+  const uint8x16_t dig = vcleq_u8(vsubq_u8(v, vdupq_n_u8('0')), vdupq_n_u8(9));
+  const uint8x16_t dot = vceqq_u8(v, vdupq_n_u8('.'));
+  const uint8x16_t exq = vceqq_u8(vorrq_u8(v, vdupq_n_u8(0x20)), vdupq_n_u8('e'));
+  return {neon_movemask(dig), neon_movemask(dot), neon_movemask(exq)};
+}
+
+template <class CharT>
+static inline u32 nonzero_mask16(const CharT* p) noexcept {
+  // Bit i set when p[i] != '0'. Preconditions: 16 readable units at p.
+  const uint8x16_t v = load_16_units(p);
+  return ~neon_movemask(vceqq_u8(v, vdupq_n_u8('0'))) & 0xffffu;
+}
+#endif
+
+#if CHFLOAT_SIMD_AVX2
+static inline u32 digit_mask32(const char* p) noexcept {
+  // Preconditions: 32 readable bytes at p.
+  const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  const __m256i t = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+  const __m256i dig = _mm256_cmpeq_epi8(_mm256_min_epu8(t, _mm256_set1_epi8(9)), t);
+  return static_cast<u32>(_mm256_movemask_epi8(dig));
+}
+#endif
+
+#if CHFLOAT_DISPATCH_X86
+struct cpu_features {
+  bool avx2_bmi2; // AVX2, BMI1 and BMI2: the CHFLOAT_TARGET_AVX2 kernels may run
+};
+
+static inline cpu_features detect_cpu_features() noexcept {
+  __builtin_cpu_init();
+  return {__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2")};
+}
+
+// Filled during static initialization; code that runs earlier sees all-false and takes the
+// compile-time kernels.
+inline const cpu_features host_cpu = detect_cpu_features();
+
+static CHFLOAT_TARGET_AVX2 const char* digit_run_end_avx2(const char* p, const char* last) noexcept {
+  // The 32-byte loop of digit_run_end. Returns at the first non-digit, or with < 32 bytes left.
+  while ((last - p) >= 32) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const __m256i t = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+    const __m256i dig = _mm256_cmpeq_epi8(_mm256_min_epu8(t, _mm256_set1_epi8(9)), t);
+    const u32 m = ~static_cast<u32>(_mm256_movemask_epi8(dig));
+    if (m != 0) return p + __builtin_ctz(m);
+    p += 32;
+  }
+  return p;
+}
+#endif
 
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 inline const CharT* digit_run_end(const CharT* p, const CharT* last) noexcept {
+  // Returns the first position in [p, last) that is not '0'..'9' (or last). The 32-byte AVX2
+  // loops are char only; wider units go through the narrowing 16-unit blocks.
+  if (!is_constant_evaluated()) {
+#if CHFLOAT_DISPATCH_X86 && !CHFLOAT_SIMD_AVX2
+    // Runs this long are rare (they mostly come from long mantissas), so the out-of-line call
+    // only happens where the wider loop pays for it.
+    if constexpr (sizeof(CharT) == 1) {
+      if ((last - p) >= 32 && host_cpu.avx2_bmi2) {
+        p = digit_run_end_avx2(p, last);
+        if ((last - p) >= 32) return p;
+      }
+    }
+#endif
+#if CHFLOAT_SIMD_AVX2
+    if constexpr (sizeof(CharT) == 1) {
+      while ((last - p) >= 32) {
+        const u32 m = ~digit_mask32(p);
+        if (m != 0) return p + tz32(m);
+        p += 32;
+      }
+    }
+#endif
+#if CHFLOAT_SIMD_SSE2 || CHFLOAT_SIMD_NEON
+    while ((last - p) >= 16) {
+      const u32 m = ~classify_block16(p).digits & 0xffffu;
+      if (m != 0) return p + tz32(m);
+      p += 16;
+    }
+#endif
+  }
   while ((last - p) >= 8) {
-    const u64 w = load_u64_unaligned(p);
-    if (!all_8_digits(w)) break;
-    count += 8;
-    any_nonzero |= any_nonzero_digit_8(w);
+    if (!all_8_digits(load_8_units(p))) break;
     p += 8;
   }
-  while (p < last) {
-    const unsigned d = digit_u8(static_cast<unsigned char>(*p));
-    if (d > 9) break;
-    ++count;
-    any_nonzero |= (d != 0);
-    ++p;
-  }
+  while (p < last && digit_of(*p) <= 9) ++p;
   return p;
 }
 
-static inline dec64 parse_decimal_19_impl(const char* p, const char* last, bool neg) noexcept {
-  dec64 r{};
-  r.ptr = p;
-  r.ec = fp_invalid_argument;
-  r.exact = false;
+static CHFLOAT_CONSTEXPR20 inline u64 non_digit_bytes_8(u64 x) noexcept {
+  // 0x80 in every byte of x that is not '0'..'9'. Only the lowest flagged byte is reliable:
+  // borrows and carries travel towards later bytes.
+  return ((x + 0x4646464646464646ULL) | (x - 0x3030303030303030ULL)) & 0x8080808080808080ULL;
+}
 
-  if (p == last) return r;
+static inline const char* digit_run_end_padded(const char* p, const char* last) noexcept {
+  // digit_run_end with full-width loads: bytes at and past `last` are masked out of the
+  // classification instead of being excluded by the loop condition.
+  // Preconditions: p <= last, fp_padding readable bytes past last.
+  for (;;) {
+    const usize len = static_cast<usize>(last - p);
+#if CHFLOAT_SIMD_SSE2 || CHFLOAT_SIMD_NEON
+    u32 m = ~classify_block16(p).digits & 0xffffu;
+    if (len < 16) m |= ~0u << len;
+    if (m != 0) return p + tz32(m);
+    p += 16;
+#else
+    u64 nd = non_digit_bytes_8(load_u64_unaligned(p));
+    if (len < 8) nd |= 0x8080808080808080ULL << (8 * len);
+    if (nd != 0) return p + (tz64(nd) >> 3);
+    p += 8;
+#endif
+  }
+}
 
-  u64 mant = 0;
-  i32 exp10 = 0;
-  bool any = false;
-  int sig = 0;
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 inline bool any_nonzero_digit(const CharT* p, const CharT* q) noexcept {
+  // Preconditions: [p, q) holds only '0'..'9'.
+#if CHFLOAT_SIMD_SSE2 || CHFLOAT_SIMD_NEON
+  if (!is_constant_evaluated()) {
+    while ((q - p) >= 16) {
+      if (nonzero_mask16(p) != 0) return true;
+      p += 16;
+    }
+  }
+#endif
+  while ((q - p) >= 8) {
+    if (any_nonzero_digit_8(load_8_units(p))) return true;
+    p += 8;
+  }
+  for (; p < q; ++p) {
+    if (*p != '0') return true;
+  }
+  return false;
+}
+
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 inline const CharT* scan_digits_fast(const CharT* p, const CharT* last, i32& count,
+                                                                 bool& any_nonzero) noexcept {
+  // Scan a run of digits, counting how many and whether any digit is non-zero.
+  const CharT* q = digit_run_end(p, last);
+  count = static_cast<i32>(q - p);
+  any_nonzero = any_nonzero_digit(p, q);
+  return q;
+}
+
+template <bool Padded = false, class CharT>
+static CHFLOAT_CONSTEXPR20 CHFLOAT_FORCE_INLINE void locate_digit_runs(const CharT* p, const CharT* last,
+                                                                       const CharT*& int_end,
+                                                                       const CharT*& frac_end) noexcept {
+  // Finds the integer digit run [p, int_end) and, when a '.' follows it, the fractional run
+  // [int_end + 1, frac_end). frac_end == nullptr means there is no '.'.
+  // Tokens that fit in one 16-unit block are laid out from a single classification. Padded:
+  // the block is always loaded, with the bytes past `last` masked out (preconditions: p < last).
+#if CHFLOAT_SIMD_SSE2 || CHFLOAT_SIMD_NEON
+  if (!is_constant_evaluated() && (Padded || (last - p) >= 16)) {
+    const block_class c = classify_block16(p);
+    u32 nd = ~c.digits & 0xffffu;
+    u32 dots = c.dots;
+    if constexpr (Padded) {
+      const usize len = static_cast<usize>(last - p);
+      if (len < 16) {
+        nd |= ~0u << len;
+        dots &= ~(~0u << len);
+      }
+    }
+    if (nd != 0) {
+      const int i = tz32(nd);
+      int_end = p + i;
+      if ((dots >> i) & 1u) {
+        const u32 fnd = nd & ~((2u << i) - 1u) & 0xffffu;
+        if (fnd != 0) {
+          frac_end = p + tz32(fnd);
+        } else if constexpr (Padded) {
+          frac_end = digit_run_end_padded(p + 16, last);
+        } else {
+          frac_end = digit_run_end(p + 16, last);
+        }
+      } else {
+        frac_end = nullptr;
+      }
+      return;
+    }
+  }
+#endif
+  if constexpr (Padded) {
+    int_end = digit_run_end_padded(p, last);
+    frac_end = (int_end < last && *int_end == '.') ? digit_run_end_padded(int_end + 1, last) : nullptr;
+  } else {
+    int_end = digit_run_end(p, last);
+    if (int_end < last && *int_end == '.') {
+      frac_end = digit_run_end(int_end + 1, last);
+    } else {
+      frac_end = nullptr;
+    }
+  }
+}
+
+// Running state of the bounded decimal parser: at most MaxSig significant digits are kept in
+// mant; further digits are truncated and only remembered as "a non-zero digit was dropped".
+struct dec_acc {
+  u64 mant;
+  i32 exp10;
+  int sig;
+  bool inexact;
+};
+
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 CHFLOAT_FORCE_INLINE void drop_digit_run(const CharT* p, const CharT* q, bool frac,
+                                                                    dec_acc& a) noexcept {
+  // [p, q) are digits past the MaxSig budget: in the integer part they scale the kept mantissa,
+  // in the fraction they don't.
+  // Preconditions: p < q, [p, q) holds only '0'..'9'.
+  if (!frac) a.exp10 += static_cast<i32>(q - p);
+  a.inexact |= any_nonzero_digit(p, q);
+}
 
-  bool dropped = false;
-  unsigned dropped_first = 0;
-  bool dropped_tail = false;
+template <int MaxSig, class CharT>
+static CHFLOAT_CONSTEXPR20 CHFLOAT_FORCE_INLINE void accumulate_digit_run(const CharT* p, const CharT* q,
+                                                                          const CharT* last, bool frac,
+                                                                          dec_acc& a) noexcept {
+  // Preconditions: [p, q) holds only '0'..'9', q <= last.
+  if (a.sig == 0) {
+    // Leading zeros are not significant; in the fraction they still scale the value.
+    const CharT* z = p;
+    while (z < q && *z == '0') ++z;
+    if (frac) a.exp10 -= static_cast<i32>(z - p);
+    p = z;
+  }
+
+  const i32 n = static_cast<i32>(q - p);
+  const i32 room = MaxSig - a.sig;
+  const i32 take = (n < room) ? n : room;
+  u64 mant = a.mant;
+  i32 i = 0;
+  for (; (take - i) >= 8; i += 8) {
+    mant = mant * 100000000ULL + eight_digits_to_u32(load_8_units(p + i));
+  }
+  const i32 rem = take - i;
+  if (rem != 0) {
+    if ((last - (p + i)) >= 8) {
+      // 1..7 digits: shift them to the top of the word and pad the low bytes with '0'.
+      const u64 w = load_8_units(p + i) << (8 * (8 - rem));
+      mant = mant * pow10_u64(rem) + eight_digits_to_u32(w | (0x3030303030303030ULL >> (8 * rem)));
+    } else {
+      for (; i < take; ++i) {
+        mant = mant * 10ULL + static_cast<u64>(digit_of(p[i]));
+      }
+    }
+  }
+  a.mant = mant;
+  a.sig += take;
+  if (frac) a.exp10 -= take;
+  if (take < n) drop_digit_run(p + take, q, frac, a);
+}
 
+template <int MaxSig, class CharT>
+static CHFLOAT_CONSTEXPR20 CHFLOAT_FORCE_INLINE const CharT* accumulate_digits_scalar(const CharT* p,
+                                                                                      const CharT* last, bool frac,
+                                                                                      dec_acc& a) noexcept {
+  // Single-pass variant for short tails: classify and accumulate each byte in one step.
+  // Leading zeros are folded into mant (it stays 0) without being counted as significant.
+  u64 mant = a.mant;
+  int sig = a.sig;
+  const CharT* const start = p;
+  while ((last - p) >= 8) {
+    // Digits in this word: the lowest flagged byte of the all_8_digits test is the first
+    // non-digit (borrows and carries only travel towards later bytes).
+    const u64 w = load_8_units(p);
+    const u64 nd = non_digit_bytes_8(w);
+    const int k = (nd == 0) ? 8 : (tz64(nd) >> 3);
+    if (k == 0 || (sig + k) > MaxSig) break;
+
+    const u64 wk = (k == 8) ? w : ((w << (8 * (8 - k))) | (0x3030303030303030ULL >> (8 * k)));
+    if (mant == 0) {
+      // Only the digits from the first non-zero byte on are significant.
+      const u64 nz = (wk - 0x3030303030303030ULL) >> (8 * (8 - k));
+      if (nz != 0) sig += k - (tz64(nz) >> 3);
+    } else {
+      sig += k;
+    }
+    mant = mant * pow10_u64(k) + eight_digits_to_u32(wk);
+    p += k;
+    if (k != 8) break;
+  }
   while (p < last) {
-    unsigned d = digit_u8(static_cast<unsigned char>(*p));
+    const unsigned d = digit_of(*p);
     if (d > 9) break;
-    any = true;
-    if (sig < 19) {
-      mant = mant * 10ULL + static_cast<u64>(d);
-      ++sig;
-      ++p;
-      continue;
+    if (sig == MaxSig) {
+      const CharT* q = digit_run_end(p, last);
+      drop_digit_run(p, q, frac, a);
+      if (frac) a.exp10 -= static_cast<i32>(p - start);
+      a.mant = mant;
+      a.sig = sig;
+      return q;
     }
-    // first dropped digit
-    dropped = true;
-    dropped_first = d;
-    ++exp10;
+    mant = mant * 10ULL + static_cast<u64>(d);
+    sig += (mant != 0);
     ++p;
-    // bulk-scan remaining integer digits
-    i32 n = 0;
-    bool nz = false;
-    const char* np = scan_digits_fast(p, last, n, nz);
-    exp10 += n;
-    dropped_tail |= nz;
-    p = np;
-    break;
   }
+  if (frac) a.exp10 -= static_cast<i32>(p - start);
+  a.mant = mant;
+  a.sig = sig;
+  return p;
+}
 
-  if (p < last && *p == '.') {
+template <bool Padded = false, class CharT>
+static CHFLOAT_CONSTEXPR20 inline const CharT* parse_exponent(const CharT* p, const CharT* last, i32& exp10) noexcept {
+  // p points at the exponent marker ('e'/'E', or 'p'/'P' for hex floats). Adds the exponent to
+  // exp10 and returns the end of the exponent, or p itself when no digits follow (then the
+  // marker is not part of the number).
+  const CharT* const epos = p;
+  ++p;
+  bool eneg = false;
+  if (p < last && (*p == '-' || *p == '+')) {
+    eneg = (*p == '-');
     ++p;
-    while (p < last) {
-      unsigned d = digit_u8(static_cast<unsigned char>(*p));
-      if (d > 9) break;
-      any = true;
-      if (sig < 19) {
-        mant = mant * 10ULL + static_cast<u64>(d);
-        ++sig;
-        --exp10;
+  }
+  if constexpr (Padded) {
+    // Up to 7 digits from one word, the digits past `last` masked out.
+    const u64 w = load_u64_unaligned(p);
+    u64 nd = non_digit_bytes_8(w);
+    const usize len = static_cast<usize>(last - p);
+    if (len < 8) nd |= 0x8080808080808080ULL << (8 * len);
+    if (nd != 0) {
+      const int k = tz64(nd) >> 3;
+      if (k == 0) return epos;
+      const i32 e = static_cast<i32>(eight_digits_to_u32((w << (8 * (8 - k))) | (0x3030303030303030ULL >> (8 * k))));
+      exp10 += eneg ? -e : e;
+      return p + k;
+    }
+  }
+  if (p == last || !is_digit(*p)) return epos;
+
+  // Fast path: exponent is almost always 1–2 digits in our benchmarks.
+  i32 e = static_cast<i32>(digit_of(*p++));
+  if (p < last) {
+    unsigned d1 = digit_of(*p);
+    if (d1 <= 9) {
+      e = e * 10 + static_cast<i32>(d1);
+      ++p;
+      // Rare fallback: 3+ digits. Saturating at 10^8 keeps exp10 + e in range while still
+      // letting a long run of digits (which shifts exp10 the other way) cancel it exactly.
+      while (p < last) {
+        unsigned d = digit_of(*p);
+        if (d > 9) break;
+        if (e < 100000000) e = e * 10 + static_cast<i32>(d);
         ++p;
-        continue;
-      }
-      if (!dropped) {
-        dropped = true;
-        dropped_first = d;
-      } else {
-        dropped_tail |= (d != 0);
       }
-      --exp10;
+    }
+  }
+  exp10 += eneg ? -e : e;
+  return p;
+}
+
+template <int MaxSig, int Fmt = fp_fmt_general, bool Padded = false, class CharT>
+static CHFLOAT_CONSTEXPR20 CHFLOAT_FORCE_INLINE basic_dec64<CharT> parse_decimal_n_impl(const CharT* p,
+                                                                                        const CharT* last,
+                                                                                        bool neg) noexcept {
+  // Bounded decimal parser shared by the binary64 (19 digits) and binary32 (10 digits) paths.
+  // Fmt (an fp_fmt) selects the exponent grammar at compile time. Padded: fp_padding readable
+  // bytes follow `last`, so even short tokens take the block path.
+  static_assert(MaxSig >= 2 && MaxSig <= 19, "mantissa must fit in 64 bits");
+  static_assert(!Padded || sizeof(CharT) == 1, "padded parsing reads char input only");
+  const CharT* const digits = p;
+  basic_dec64<CharT> r{};
+  r.ptr = p;
+  r.ec = fp_invalid_argument;
+  r.exact = false;
+
+  if (p == last) return r;
+
+  dec_acc a{0, 0, 0, false};
+
+  bool any = false;
+  const CharT* int_end_at = p; // end of the integer digit run
+  bool dot = false;           // a '.' was taken
+  bool frac_digits = false;   // ... followed by at least one digit
+  if (Padded || (last - p) >= 16) {
+    // Enough bytes for a full block: find the digit runs first, then accumulate them without
+    // per-byte classification.
+    const CharT* int_end = p;
+    const CharT* frac_end = nullptr;
+    locate_digit_runs<Padded>(p, last, int_end, frac_end);
+
+    // Only the loads need the padding; the digit runs already end at or before `last`.
+    const CharT* const readable = Padded ? last + fp_padding : last;
+    any = (int_end != p);
+    accumulate_digit_run<MaxSig>(p, int_end, readable, false, a);
+    p = int_end;
+    int_end_at = int_end;
+    if (frac_end != nullptr) {
+      dot = true;
+      frac_digits = (frac_end != int_end + 1);
+      any |= frac_digits;
+      accumulate_digit_run<MaxSig>(int_end + 1, frac_end, readable, true, a);
+      p = frac_end;
+    }
+  } else {
+    const CharT* q = accumulate_digits_scalar<MaxSig>(p, last, false, a);
+    any = (q != p);
+    p = q;
+    int_end_at = q;
+    if (p < last && *p == '.') {
       ++p;
-      // bulk-scan remaining fractional digits
-      i32 n = 0;
-      bool nz = false;
-      const char* np = scan_digits_fast(p, last, n, nz);
-      exp10 -= n;
-      dropped_tail |= nz;
-      p = np;
-      break;
+      q = accumulate_digits_scalar<MaxSig>(p, last, true, a);
+      dot = true;
+      frac_digits = (q != p);
+      any |= frac_digits;
+      p = q;
     }
   }
 
@@ -321,66 +1013,68 @@ static inline dec64 parse_decimal_19_impl(const char* p, const char* last, bool
     r.ec = fp_invalid_argument;
     return r;
   }
-
-  if (p < last && (*p == 'e' || *p == 'E')) {
-    const char* epos = p;
-    ++p;
-    bool eneg = false;
-    if (p < last && (*p == '-' || *p == '+')) {
-      eneg = (*p == '-');
-      ++p;
-    }
-    if (p == last || !is_digit(*p)) {
-      p = epos;
-    } else {
-      // Fast path: exponent is almost always 1–2 digits in our benchmarks.
-      i32 e = static_cast<i32>(digit_u8(static_cast<unsigned char>(*p++)));
-      if (p < last) {
-        unsigned d1 = digit_u8(static_cast<unsigned char>(*p));
-        if (d1 <= 9) {
-          e = e * 10 + static_cast<i32>(d1);
-          ++p;
-          // Rare fallback: 3+ digits.
-          while (p < last) {
-            unsigned d = digit_u8(static_cast<unsigned char>(*p));
-            if (d > 9) break;
-            if (e < 10000) e = e * 10 + static_cast<i32>(d);
-            ++p;
-          }
-        }
-      }
-      if (eneg) e = -e;
-      exp10 = static_cast<i32>(exp10 + e);
+  if constexpr (Fmt == fp_fmt_json) {
+    // An integer part (no leading zeros), and digits after any '.'.
+    const i32 int_len = static_cast<i32>(int_end_at - digits);
+    if (int_len == 0 || (int_len > 1 && *digits == '0') || (dot && !frac_digits)) {
+      r.ec = fp_invalid_argument;
+      return r;
     }
   }
-
-  if (dropped) {
-    const bool round_up = (dropped_first > 5) || (dropped_first == 5 && (dropped_tail || (mant & 1ULL)));
-    if (round_up) {
-      ++mant;
-      constexpr u64 p10 = 10000000000000000000ULL; // 10^19
-      if (mant == p10) {
-        mant = 1000000000000000000ULL; // 10^18
-        ++exp10;
+  bool has_exp = false;
+
+  i32 exp10 = a.exp10;
+  if constexpr (Fmt == fp_fmt_scientific) {
+    const CharT* q = (p < last && (*p == 'e' || *p == 'E')) ? parse_exponent<Padded>(p, last, exp10) : p;
+    if (q == p) {
+      r.ec = fp_invalid_argument;
+      return r;
+    }
+    p = q;
+    has_exp = true;
+  } else if constexpr (Fmt == fp_fmt_general) {
+    if (p < last && (*p == 'e' || *p == 'E')) {
+      const CharT* q = parse_exponent<Padded>(p, last, exp10);
+      has_exp = (q != p);
+      p = q;
+    }
+  } else if constexpr (Fmt == fp_fmt_json) {
+    if (p < last && (*p == 'e' || *p == 'E')) {
+      // "1e" / "1e+" are malformed JSON, not "1" followed by garbage.
+      const CharT* q = parse_exponent<Padded>(p, last, exp10);
+      if (q == p) {
+        r.ec = fp_invalid_argument;
+        return r;
       }
+      has_exp = true;
+      p = q;
     }
   }
 
-  r.mant = mant;
+  r.mant = a.mant;
   r.exp10 = exp10;
   r.neg = neg;
-  r.exact = !dropped;
+  r.exact = !a.inexact;
+  r.digits = digits;
+  r.integer = !dot && !has_exp;
   r.ptr = p;
   r.ec = fp_ok;
   return r;
 }
 
-static inline dec64 parse_decimal_19(const char* first, const char* last) noexcept {
-  dec64 r{};
+template <int Fmt = fp_fmt_general, bool Padded = false, class CharT>
+static CHFLOAT_CONSTEXPR20 inline basic_dec64<CharT> parse_decimal_19_impl(const CharT* p, const CharT* last,
+                                                                          bool neg) noexcept {
+  return parse_decimal_n_impl<19, Fmt, Padded>(p, last, neg);
+}
+
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 inline basic_dec64<CharT> parse_decimal_19(const CharT* first, const CharT* last) noexcept {
+  basic_dec64<CharT> r{};
   r.ptr = first;
   r.ec = fp_invalid_argument;
 
-  const char* p = first;
+  const CharT* p = first;
   if (p == last) return r;
 
   bool neg = false;
@@ -398,141 +1092,20 @@ static inline dec64 parse_decimal_19(const char* first, const char* last) noexce
   return r;
 }
 
-static inline dec64 parse_decimal_10_impl(const char* p, const char* last, bool neg) noexcept {
+template <int Fmt = fp_fmt_general, bool Padded = false, class CharT>
+static CHFLOAT_CONSTEXPR20 inline basic_dec64<CharT> parse_decimal_10_impl(const CharT* p, const CharT* last,
+                                                                          bool neg) noexcept {
   // Same parser but capped at 10 significant digits (float-friendly).
-  dec64 r{};
-  r.ptr = p;
+  return parse_decimal_n_impl<10, Fmt, Padded>(p, last, neg);
+}
+
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 inline basic_dec64<CharT> parse_decimal_10(const CharT* first, const CharT* last) noexcept {
+  basic_dec64<CharT> r{};
+  r.ptr = first;
   r.ec = fp_invalid_argument;
-  r.exact = false;
 
-  if (p == last) return r;
-
-  u64 mant = 0;
-  i32 exp10 = 0;
-  bool any = false;
-  int sig = 0;
-
-  bool dropped = false;
-  unsigned dropped_first = 0;
-  bool dropped_tail = false;
-
-  while (p < last) {
-    unsigned d = digit_u8(static_cast<unsigned char>(*p));
-    if (d > 9) break;
-    any = true;
-    if (sig < 10) {
-      mant = mant * 10ULL + static_cast<u64>(d);
-      ++sig;
-      ++p;
-      continue;
-    }
-    dropped = true;
-    dropped_first = d;
-    ++exp10;
-    ++p;
-    i32 n = 0;
-    bool nz = false;
-    const char* np = scan_digits_fast(p, last, n, nz);
-    exp10 += n;
-    dropped_tail |= nz;
-    p = np;
-    break;
-  }
-
-  if (p < last && *p == '.') {
-    ++p;
-    while (p < last) {
-      unsigned d = digit_u8(static_cast<unsigned char>(*p));
-      if (d > 9) break;
-      any = true;
-      if (sig < 10) {
-        mant = mant * 10ULL + static_cast<u64>(d);
-        ++sig;
-        --exp10;
-        ++p;
-        continue;
-      }
-      if (!dropped) {
-        dropped = true;
-        dropped_first = d;
-      } else {
-        dropped_tail |= (d != 0);
-      }
-      --exp10;
-      ++p;
-
-      i32 n = 0;
-      bool nz = false;
-      const char* np = scan_digits_fast(p, last, n, nz);
-      exp10 -= n;
-      dropped_tail |= nz;
-      p = np;
-      break;
-    }
-  }
-
-  if (!any) {
-    r.ec = fp_invalid_argument;
-    return r;
-  }
-
-  if (p < last && (*p == 'e' || *p == 'E')) {
-    const char* epos = p;
-    ++p;
-    bool eneg = false;
-    if (p < last && (*p == '-' || *p == '+')) {
-      eneg = (*p == '-');
-      ++p;
-    }
-    if (p == last || !is_digit(*p)) {
-      p = epos;
-    } else {
-      i32 e = static_cast<i32>(digit_u8(static_cast<unsigned char>(*p++)));
-      if (p < last) {
-        unsigned d1 = digit_u8(static_cast<unsigned char>(*p));
-        if (d1 <= 9) {
-          e = e * 10 + static_cast<i32>(d1);
-          ++p;
-          while (p < last) {
-            unsigned d = digit_u8(static_cast<unsigned char>(*p));
-            if (d > 9) break;
-            if (e < 10000) e = e * 10 + static_cast<i32>(d);
-            ++p;
-          }
-        }
-      }
-      if (eneg) e = -e;
-      exp10 = static_cast<i32>(exp10 + e);
-    }
-  }
-
-  if (dropped) {
-    const bool round_up = (dropped_first > 5) || (dropped_first == 5 && (dropped_tail || (mant & 1ULL)));
-    if (round_up) {
-      ++mant;
-      constexpr u64 p10 = 10000000000ULL; // 10^10
-      if (mant == p10) {
-        mant = 1000000000ULL; // 10^9
-        ++exp10;
-      }
-    }
-  }
-
-  r.mant = mant;
-  r.exp10 = exp10;
-  r.neg = neg;
-  r.exact = !dropped;
-  r.ptr = p;
-  r.ec = fp_ok;
-  return r;
-}
-
-static inline dec64 parse_decimal_10(const char* first, const char* last) noexcept {
-  dec64 r{};
-  r.ptr = first;
-  r.ec = fp_invalid_argument;
-
-  const char* p = first;
+  const CharT* p = first;
   if (p == last) return r;
 
   bool neg = false;
@@ -550,23 +1123,27 @@ static inline dec64 parse_decimal_10(const char* first, const char* last) noexce
   return r;
 }
 
+// undecided: the truncated pow5 product left the rounding open; mant/exp are then an estimate
+// at most one ulp away from the correct result.
 struct bin64 {
   u64 mant;
   i32 exp;
+  bool undecided;
 };
 
 struct bin32 {
   u32 mant;
   i32 exp;
+  bool undecided;
 };
 
-static inline bin64 build_binary64_q0(u64 w) noexcept {
+static CHFLOAT_CONSTEXPR20 inline bin64 build_binary64_q0(u64 w) noexcept {
   // Exact integer -> binary64 conversion with round-to-nearest-even.
   // Preconditions: w != 0.
   i32 e2 = static_cast<i32>(63 - lz64(w));
   if (e2 <= 52) {
     const u64 m = w << (52 - e2);
-    return {m & ((1ULL << 52) - 1ULL), e2 + 1023};
+    return {m & ((1ULL << 52) - 1ULL), e2 + 1023, false};
   }
 
   const int shift = int(e2 - 52);
@@ -581,16 +1158,16 @@ static inline bin64 build_binary64_q0(u64 w) noexcept {
     }
   }
 
-  return {m & ((1ULL << 52) - 1ULL), e2 + 1023};
+  return {m & ((1ULL << 52) - 1ULL), e2 + 1023, false};
 }
 
-static inline bin32 build_binary32_q0(u64 w) noexcept {
+static CHFLOAT_CONSTEXPR20 inline bin32 build_binary32_q0(u64 w) noexcept {
   // Exact integer -> binary32 conversion with round-to-nearest-even.
   // Preconditions: w != 0.
   i32 e2 = static_cast<i32>(63 - lz64(w));
   if (e2 <= 23) {
     const u64 m = w << (23 - e2);
-    return {static_cast<u32>(m & ((1ULL << 23) - 1ULL)), e2 + 127};
+    return {static_cast<u32>(m & ((1ULL << 23) - 1ULL)), e2 + 127, false};
   }
 
   const int shift = int(e2 - 23);
@@ -605,10 +1182,10 @@ static inline bin32 build_binary32_q0(u64 w) noexcept {
     }
   }
 
-  return {static_cast<u32>(m & ((1ULL << 23) - 1ULL)), e2 + 127};
+  return {static_cast<u32>(m & ((1ULL << 23) - 1ULL)), e2 + 127, false};
 }
 
-static inline bin64 build_binary64(i32 q10, u64 w) noexcept {
+static CHFLOAT_CONSTEXPR20 inline bin64 build_binary64(i32 q10, u64 w) noexcept {
   // Preconditions: w != 0, q10 in [-342, 308]
   if (q10 == 0) {
     return build_binary64_q0(w);
@@ -616,18 +1193,22 @@ static inline bin64 build_binary64(i32 q10, u64 w) noexcept {
   const int z = lz64(w);
   const u64 wnorm = w << z;
 
-  const pow5_128& c = pow5_table[q10 - pow5_smallest_q];
+  const pow5_128 c = pow5_entry(q10);
 
   // 52-bit mantissa => need 55 bits of precision before rounding
   const u64 mask = (0xffffffffffffffffULL >> 55);
 
   u128 p = mul_64x64_to_128(wnorm, c.hi);
+  bool undecided = false;
   if ((p.hi & mask) == mask) {
     u128 p2 = mul_64x64_to_128(wnorm, c.lo);
     const u64 new_lo = p.lo + p2.hi;
     const u64 carry = (new_lo < p.lo) ? 1ULL : 0ULL;
     p.lo = new_lo;
     p.hi = p.hi + carry;
+    // The cached 5^q is only 128 bits wide: with the low word saturated as well, the bits that
+    // were cut off could still move the kept ones. q in [-27, 55] is known to never get here.
+    undecided = (p.lo == 0xffffffffffffffffULL) && ((p.hi & mask) == mask) && (q10 < -27 || q10 > 55);
   }
 
   const int upper = int(p.hi >> 63);
@@ -638,13 +1219,13 @@ static inline bin64 build_binary64(i32 q10, u64 w) noexcept {
 
   if (e2 <= 0) {
     const int rshift = -e2 + 1;
-    if (rshift >= 64) return {0ULL, 0};
+    if (rshift >= 64) return {0ULL, 0, undecided};
     m >>= rshift;
     m += (m & 1ULL);
     m >>= 1;
     const i32 be = (m < (1ULL << 52)) ? 0 : 1;
     const u64 mb = (m & ((1ULL << 52) - 1ULL));
-    return {mb, be};
+    return {mb, be, undecided};
   }
 
   if ((m & 3ULL) == 1ULL) {
@@ -662,30 +1243,32 @@ static inline bin64 build_binary64(i32 q10, u64 w) noexcept {
   }
 
   m &= ~(1ULL << 52);
-  if (e2 >= 0x7FF) return {0ULL, 0x7FF};
+  if (e2 >= 0x7FF) return {0ULL, 0x7FF, undecided};
 
-  return {m, e2};
+  return {m, e2, undecided};
 }
 
-static inline bin32 build_binary32(i32 q10, u64 w) noexcept {
-  // Preconditions: w != 0, q10 in [-64, 38]
-  if (q10 == 0) {
-    return build_binary32_q0(w);
-  }
+static CHFLOAT_CONSTEXPR20 inline bin32 build_binary32_128(i32 q10, u64 w) noexcept {
+  // Eisel-Lemire on the 128-bit table, for the cases build_binary32 cannot settle.
+  // Preconditions: w != 0, q10 in [-64, 38], q10 != 0
   const int z = lz64(w);
   const u64 wnorm = w << z;
 
-  const pow5_128& c = pow5_table[q10 - pow5_smallest_q];
+  const pow5_128 c = pow5_entry(q10);
 
   const u64 mask = (0xffffffffffffffffULL >> 26);
 
   u128 p = mul_64x64_to_128(wnorm, c.hi);
+  bool undecided = false;
   if ((p.hi & mask) == mask) {
     u128 p2 = mul_64x64_to_128(wnorm, c.lo);
     const u64 new_lo = p.lo + p2.hi;
     const u64 carry = (new_lo < p.lo) ? 1ULL : 0ULL;
     p.lo = new_lo;
     p.hi = p.hi + carry;
+    // The cached 5^q is only 128 bits wide: with the low word saturated as well, the bits that
+    // were cut off could still move the kept ones. q in [-27, 55] is known to never get here.
+    undecided = (p.lo == 0xffffffffffffffffULL) && ((p.hi & mask) == mask) && (q10 < -27 || q10 > 55);
   }
 
   const int upper = int(p.hi >> 63);
@@ -696,13 +1279,13 @@ static inline bin32 build_binary32(i32 q10, u64 w) noexcept {
 
   if (e2 <= 0) {
     const int rshift = -e2 + 1;
-    if (rshift >= 64) return {0u, 0};
+    if (rshift >= 64) return {0u, 0, undecided};
     m >>= rshift;
     m += (m & 1ULL);
     m >>= 1;
     const i32 be = (m < (1ULL << 23)) ? 0 : 1;
     const u32 mb = static_cast<u32>(m & ((1ULL << 23) - 1ULL));
-    return {mb, be};
+    return {mb, be, undecided};
   }
 
   if ((m & 3ULL) == 1ULL) {
@@ -720,89 +1303,285 @@ static inline bin32 build_binary32(i32 q10, u64 w) noexcept {
   }
 
   m &= ~(1ULL << 23);
-  if (e2 >= 0xFF) return {0u, 0xFF};
+  if (e2 >= 0xFF) return {0u, 0xFF, undecided};
 
-  return {static_cast<u32>(m), e2};
+  return {static_cast<u32>(m), e2, undecided};
 }
 
-static inline fp_chars_result parse_fp_double(const char* first, const char* last, double& value) noexcept {
-  // Handle optional leading sign for special tokens.
-  const char* p = first;
-  bool neg = false;
-  if (p < last && (*p == '-' || *p == '+')) {
-    neg = (*p == '-');
-    ++p;
+static CHFLOAT_CONSTEXPR20 inline bin32 build_binary32(i32 q10, u64 w) noexcept {
+  // Preconditions: w != 0, q10 in [-64, 38]
+  if (q10 == 0) {
+    return build_binary32_q0(w);
   }
+  const int z = lz64(w);
+  const u64 wnorm = w << z;
+
+  // One 64x64 multiply on the truncated 64-bit 5^q. The exact product lies in
+  // [p, p + wnorm), so at most a carry of one reaches p.hi. The kept bits are final unless the
+  // bits below them are all ones; a possible tie or a subnormal result goes to the 128-bit path.
+  const u128 p = mul_64x64_to_128(wnorm, pow5_float_table[q10 - pow5_float_smallest_q]);
+  const u64 mask = (0xffffffffffffffffULL >> 26);
+  if ((p.hi & mask) == mask) return build_binary32_128(q10, w);
+
+  const int upper = int(p.hi >> 63);
+  const int shift = upper + 64 - 23 - 3;
+  u64 m = p.hi >> shift;
+  i32 e2 = approx_log2_pow5(q10) + upper - z - (-127);
+  // Bitwise on purpose: the low bits of m are random, so a short-circuit branch would mispredict.
+  if ((e2 <= 0) | (((m & 3ULL) == 1ULL) & ((m << shift) == p.hi))) return build_binary32_128(q10, w);
+
+  m += (m & 1ULL);
+  m >>= 1;
+  if (m >= (2ULL << 23)) {
+    m = (1ULL << 23);
+    ++e2;
+  }
+  m &= ~(1ULL << 23);
+  if (e2 >= 0xFF) return {0u, 0xFF, false};
+  return {static_cast<u32>(m), e2, false};
+}
+
+// Exact fallback for inputs whose truncated mantissa leaves the rounding undecided.
+//
+// The decimal is re-scanned into a fixed-size big integer (up to big_decimal_max_digits
+// significant digits; later digits only set a sticky flag, which is enough because a halfway
+// point between two binary64 values has at most 767 significant digits) and compared exactly
+// against the halfway points around an estimate that is at most one ulp off. No allocation:
+// every operand lives in a stack buffer sized for the worst case (a subnormal halfway point
+// scaled by 5^1100 and 2^1100, well under 4096 bits).
+
+static constexpr int big_decimal_max_digits = 800;
+
+struct bigint {
+  static constexpr int capacity = 64; // u64 limbs, little-endian
+  u64 limb[capacity];
+  int len;
+};
+
+static CHFLOAT_CONSTEXPR20 inline void big_mul_add(bigint& b, u64 mul, u64 add) noexcept {
+  // b = b * mul + add
+  u64 carry = add;
+  for (int i = 0; i < b.len; ++i) {
+    const u128 p = mul_64x64_to_128(b.limb[i], mul);
+    const u64 lo = p.lo + carry;
+    carry = p.hi + ((lo < p.lo) ? 1ULL : 0ULL);
+    b.limb[i] = lo;
+  }
+  if (carry != 0 && b.len < bigint::capacity) b.limb[b.len++] = carry;
+}
 
-  // Specials: nan/inf/infinity (ASCII, case-insensitive).
+static CHFLOAT_CONSTEXPR20 inline void big_mul_pow5(bigint& b, i32 k) noexcept {
+  for (; k >= 27; k -= 27) big_mul_add(b, 7450580596923828125ULL, 0); // 5^27
+  u64 m = 1;
+  for (; k > 0; --k) m *= 5ULL;
+  if (m != 1) big_mul_add(b, m, 0);
+}
+
+static CHFLOAT_CONSTEXPR20 inline void big_shl(bigint& b, i32 n) noexcept {
+  // Preconditions: n >= 0, the result fits in bigint::capacity limbs.
+  if (b.len == 0 || n == 0) return;
+  const int words = int(n >> 6);
+  const int bits = int(n & 63);
+  int len = b.len + words;
+  if (bits != 0) {
+    b.limb[len] = 0;
+    for (int i = b.len - 1; i >= 0; --i) {
+      b.limb[i + words + 1] |= b.limb[i] >> (64 - bits);
+      b.limb[i + words] = b.limb[i] << bits;
+    }
+    if (b.limb[len] != 0) ++len;
+  } else {
+    for (int i = b.len - 1; i >= 0; --i) b.limb[i + words] = b.limb[i];
+  }
+  for (int i = 0; i < words; ++i) b.limb[i] = 0;
+  b.len = len;
+}
+
+static CHFLOAT_CONSTEXPR20 inline int big_compare(const bigint& a, const bigint& b) noexcept {
+  if (a.len != b.len) return (a.len < b.len) ? -1 : 1;
+  for (int i = a.len - 1; i >= 0; --i) {
+    if (a.limb[i] != b.limb[i]) return (a.limb[i] < b.limb[i]) ? -1 : 1;
+  }
+  return 0;
+}
+
+// The value M * 10^exp10 of a decimal string, plus whether non-zero digits were cut off.
+struct big_decimal {
+  bigint mant;
+  i32 exp10;
+  bool truncated;
+};
+
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 inline void parse_big_decimal(const CharT* p, const CharT* last, big_decimal& d) noexcept {
+  // Re-scans a decimal that parse_decimal_n_impl already accepted: p is its first digit (or
+  // '.'), last is its end. Grammar errors are impossible here.
+  d.mant.len = 0;
+  d.exp10 = 0;
+  d.truncated = false;
+  int ndigits = 0;
+  u64 chunk = 0;
+  int chunk_len = 0;
+  bool frac = false;
+  for (; p < last; ++p) {
+    if (*p == '.') {
+      frac = true;
+      continue;
+    }
+    const unsigned dv = digit_of(*p);
+    if (dv > 9) break;
+    if (ndigits == 0 && dv == 0) {
+      if (frac) --d.exp10;
+      continue;
+    }
+    if (ndigits < big_decimal_max_digits) {
+      chunk = chunk * 10ULL + dv;
+      if (++chunk_len == 19) {
+        big_mul_add(d.mant, 10000000000000000000ULL, chunk);
+        chunk = 0;
+        chunk_len = 0;
+      }
+      ++ndigits;
+      if (frac) --d.exp10;
+    } else {
+      d.truncated |= (dv != 0);
+      if (!frac) ++d.exp10;
+    }
+  }
+  if (chunk_len != 0) big_mul_add(d.mant, pow10_u64(chunk_len), chunk);
+  if (p < last) (void)parse_exponent(p, last, d.exp10);
+}
+
+static CHFLOAT_CONSTEXPR20 inline int compare_halfway(const big_decimal& d, u64 m, i32 e2) noexcept {
+  // Sign of d - m * 2^e2, with a truncated tail counting as "slightly above".
+  bigint lhs = d.mant;
+  bigint rhs;
+  if (is_constant_evaluated()) rhs = bigint{};
+  rhs.limb[0] = m;
+  rhs.len = 1;
+  if (d.exp10 >= 0) {
+    // M * 5^E * 2^E  vs  m * 2^e2
+    big_mul_pow5(lhs, d.exp10);
+    const i32 s = d.exp10 - e2;
+    if (s >= 0) {
+      big_shl(lhs, s);
+    } else {
+      big_shl(rhs, -s);
+    }
+  } else {
+    // M  vs  m * 5^-E * 2^(e2 - E)
+    big_mul_pow5(rhs, -d.exp10);
+    const i32 s = e2 - d.exp10;
+    if (s >= 0) {
+      big_shl(rhs, s);
+    } else {
+      big_shl(lhs, -s);
+    }
+  }
+  const int c = big_compare(lhs, rhs);
+  return (c == 0 && d.truncated) ? 1 : c;
+}
+
+template <class Bits, int MantBits, int Bias>
+static CHFLOAT_CONSTEXPR20 inline int compare_above(const big_decimal& d, Bits bits) noexcept {
+  // Compares d with the midpoint between the finite value `bits` and the next one up.
+  const Bits frac = bits & ((Bits(1) << MantBits) - 1);
+  const i32 be = static_cast<i32>(bits >> MantBits);
+  const u64 m = (be == 0) ? u64(frac) : (u64(frac) | (u64(1) << MantBits));
+  const i32 e2 = ((be == 0) ? 1 : be) - Bias - MantBits;
+  return compare_halfway(d, 2 * m + 1, e2 - 1);
+}
+
+template <class Bits, int MantBits, int Bias, class CharT>
+static CHFLOAT_CONSTEXPR20 inline Bits round_big_decimal(const basic_dec64<CharT>& dec, Bits estimate) noexcept {
+  // Correctly rounded (nearest, ties-to-even) bits of the positive decimal, given an estimate at
+  // most one ulp away from the answer. Infinity is the value above the maximum. Exact mantissas
+  // are used as they are; truncated ones are re-scanned from [dec.digits, dec.ptr).
+  big_decimal d;
+  // Constant evaluation may not copy the unused limbs while they are uninitialized.
+  if (is_constant_evaluated()) d = big_decimal{};
+  if (dec.exact) {
+    d.mant.len = 0;
+    big_mul_add(d.mant, 0, dec.mant);
+    d.exp10 = dec.exp10;
+    d.truncated = false;
+  } else {
+    parse_big_decimal(dec.digits, dec.ptr, d);
+  }
+  const Bits inf = Bits((Bits(1) << (sizeof(Bits) * 8 - 1 - MantBits)) - 1) << MantBits;
+  Bits b = estimate;
+  if (b < inf) {
+    const int c = compare_above<Bits, MantBits, Bias>(d, b);
+    if (c > 0 || (c == 0 && (b & 1))) return Bits(b + 1);
+    if (c == 0) return b;
+  }
+  if (b > 0) {
+    const int c = compare_above<Bits, MantBits, Bias>(d, Bits(b - 1));
+    if (c < 0 || (c == 0 && (b & 1))) return Bits(b - 1);
+  }
+  return b;
+}
+
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 inline bool parse_special_double(const CharT* p, const CharT* last, bool neg, double& value,
+                                                            const CharT*& end) noexcept {
+  // Specials: nan/inf/infinity (ASCII, case-insensitive). p points past the optional sign.
   if (p < last) {
-    const unsigned char c = static_cast<unsigned char>(*p);
+    const u32 c = code_unit(*p);
     if (c == 'n' || c == 'N') {
       if ((last - p) >= 3 && ascii_ieq3(p, "nan")) {
         u64 bits = 0x7ff8000000000000ULL;
         if (neg) bits |= (1ULL << 63);
         value = bits_to_double(bits);
-        return {p + 3, fp_ok};
+        end = p + 3;
+        return true;
       }
     } else if (c == 'i' || c == 'I') {
-      if ((last - p) >= 3 && ascii_ieq3(p, "inf")) {
+      if ((last - p) >= 8 && ascii_ieq8(p, "infinity")) {
         u64 bits = 0x7ff0000000000000ULL;
         if (neg) bits |= (1ULL << 63);
         value = bits_to_double(bits);
-        return {p + 3, fp_ok};
+        end = p + 8;
+        return true;
       }
-      if ((last - p) >= 8 && ascii_ieq8(p, "infinity")) {
+      if ((last - p) >= 3 && ascii_ieq3(p, "inf")) {
         u64 bits = 0x7ff0000000000000ULL;
         if (neg) bits |= (1ULL << 63);
         value = bits_to_double(bits);
-        return {p + 8, fp_ok};
+        end = p + 3;
+        return true;
       }
     }
   }
+  return false;
+}
 
-  // Parse decimal number (sign already handled) using the 19-digit bounded parser.
-  dec64 d = parse_decimal_19_impl(p, last, neg);
-  if (d.ec != fp_ok) return {first, d.ec};
+// fl(0.r) for the one-fractional-digit shortcut of dec64_to_double.
+inline constexpr double tenths_table[10] = {
+    0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9,
+};
 
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 CHFLOAT_FORCE_INLINE int dec64_to_double(const basic_dec64<CharT>& d,
+                                                                    double& value) noexcept {
+  // Converts a successfully parsed decimal (d.ec == fp_ok) to binary64. Returns an fp_ec value.
   // Fast path for common exact inputs: do an IEEE-754 multiply/divide by an *exact* power of 10.
   // For |exp10|<=15, 10^|exp10| is an exactly representable integer in binary64, so the operation
   // rounds exactly as required for decimal->binary64.
   if (d.exact && d.mant <= 9007199254740991ULL) { // 2^53-1
     const i32 e = d.exp10;
 
-    // Special-case the short_no_exp distribution (<=6 integer digits, <=2 fractional digits):
-    // avoid expensive floating-point division by 10/100.
+    // Special-case one fractional digit (common in short_no_exp): avoid a division by 10.
+    // q + fl(0.r) equals mant / 10.0 for every mant <= 99999999 (checked exhaustively); the
+    // same trick with a 0.rr table double-rounds (e.g. 7.94), so e == -2 divides.
     if (d.mant <= 99999999ULL) {
       if (e == -1) {
         const u64 q = d.mant / 10ULL;
         const u32 r = static_cast<u32>(d.mant - q * 10ULL);
-        static constexpr double frac10[10] = {
-            0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9,
-        };
-        double v = static_cast<double>(q) + frac10[r];
-        if (d.neg) v = -v;
-        value = v;
-        return {d.ptr, fp_ok};
-      }
-      if (e == -2) {
-        const u64 q = d.mant / 100ULL;
-        const u32 r = static_cast<u32>(d.mant - q * 100ULL);
-        static constexpr double frac100[100] = {
-            0.00, 0.01, 0.02, 0.03, 0.04, 0.05, 0.06, 0.07, 0.08, 0.09,
-            0.10, 0.11, 0.12, 0.13, 0.14, 0.15, 0.16, 0.17, 0.18, 0.19,
-            0.20, 0.21, 0.22, 0.23, 0.24, 0.25, 0.26, 0.27, 0.28, 0.29,
-            0.30, 0.31, 0.32, 0.33, 0.34, 0.35, 0.36, 0.37, 0.38, 0.39,
-            0.40, 0.41, 0.42, 0.43, 0.44, 0.45, 0.46, 0.47, 0.48, 0.49,
-            0.50, 0.51, 0.52, 0.53, 0.54, 0.55, 0.56, 0.57, 0.58, 0.59,
-            0.60, 0.61, 0.62, 0.63, 0.64, 0.65, 0.66, 0.67, 0.68, 0.69,
-            0.70, 0.71, 0.72, 0.73, 0.74, 0.75, 0.76, 0.77, 0.78, 0.79,
-            0.80, 0.81, 0.82, 0.83, 0.84, 0.85, 0.86, 0.87, 0.88, 0.89,
-            0.90, 0.91, 0.92, 0.93, 0.94, 0.95, 0.96, 0.97, 0.98, 0.99,
-        };
-        double v = static_cast<double>(q) + frac100[r];
+        double v = static_cast<double>(q) + tenths_table[r];
         if (d.neg) v = -v;
         value = v;
-        return {d.ptr, fp_ok};
+        return fp_ok;
       }
     }
 
@@ -815,7 +1594,7 @@ static inline fp_chars_result parse_fp_double(const char* first, const char* las
       }
       if (d.neg) v = -v;
       value = v;
-      return {d.ptr, fp_ok};
+      return fp_ok;
     }
   }
 
@@ -823,7 +1602,7 @@ static inline fp_chars_result parse_fp_double(const char* first, const char* las
     u64 bits = 0; // +0
     if (d.neg) bits |= (1ULL << 63);
     value = bits_to_double(bits);
-    return {d.ptr, fp_ok};
+    return fp_ok;
   }
 
   // Range guard. Single-compare form helps the hot path a bit.
@@ -838,55 +1617,132 @@ static inline fp_chars_result parse_fp_double(const char* first, const char* las
       if (d.neg) bits |= (1ULL << 63);
       value = bits_to_double(bits);
     }
-    return {d.ptr, fp_result_out_of_range};
+    return fp_result_out_of_range;
   }
 
   bin64 b = build_binary64(d.exp10, d.mant);
   u64 bits = (static_cast<u64>(b.exp) << 52) | (b.mant & ((1ULL << 52) - 1ULL));
+  bool slow = b.undecided;
+  if (!d.exact) {
+    // The truncated digits put the input strictly between mant and mant + 1 (times 10^exp10):
+    // when both ends round to the same double so does the input, otherwise compare exactly.
+    const bin64 b1 = build_binary64(d.exp10, d.mant + 1ULL);
+    slow |= b1.undecided || b1.exp != b.exp || b1.mant != b.mant;
+  }
+  if (slow) bits = round_big_decimal<u64, 52, 1023>(d, bits);
+  // Inputs just past the range guard can still round to infinity or zero.
+  const int ec = (bits == 0 || bits == 0x7ff0000000000000ULL) ? fp_result_out_of_range : fp_ok;
   if (d.neg) bits |= (1ULL << 63);
   value = bits_to_double(bits);
-  return {d.ptr, fp_ok};
+  return ec;
 }
 
-static inline fp_chars_result parse_fp_float(const char* first, const char* last, float& value) noexcept {
-  const char* p = first;
+template <int Fmt = fp_fmt_general, bool Padded = false, class CharT>
+static CHFLOAT_CONSTEXPR20 inline basic_fp_chars_result<CharT> parse_fp_double(const CharT* first, const CharT* last,
+                                                                               double& value) noexcept {
+  // Handle optional leading sign for special tokens.
+  const CharT* p = first;
   bool neg = false;
   if (p < last && (*p == '-' || *p == '+')) {
     neg = (*p == '-');
     ++p;
   }
 
-  // Specials: nan/inf/infinity (ASCII, case-insensitive).
+  const CharT* end = p;
+  if (parse_special_double(p, last, neg, value, end)) return {end, fp_ok};
+
+  // Parse decimal number (sign already handled) using the 19-digit bounded parser.
+  basic_dec64<CharT> d = parse_decimal_19_impl<Fmt, Padded>(p, last, neg);
+  if (d.ec != fp_ok) return {first, d.ec};
+  return {d.ptr, dec64_to_double(d, value)};
+}
+
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 inline bool parse_special_float(const CharT* p, const CharT* last, bool neg, float& value,
+                                                           const CharT*& end) noexcept {
+  // Specials: nan/inf/infinity (ASCII, case-insensitive). p points past the optional sign.
   if (p < last) {
-    const unsigned char c = static_cast<unsigned char>(*p);
+    const u32 c = code_unit(*p);
     if (c == 'n' || c == 'N') {
       if ((last - p) >= 3 && ascii_ieq3(p, "nan")) {
         u32 bits = 0x7fc00000u;
         if (neg) bits |= (1u << 31);
         value = bits_to_float(bits);
-        return {p + 3, fp_ok};
+        end = p + 3;
+        return true;
       }
     } else if (c == 'i' || c == 'I') {
-      if ((last - p) >= 3 && ascii_ieq3(p, "inf")) {
+      if ((last - p) >= 8 && ascii_ieq8(p, "infinity")) {
         u32 bits = 0x7f800000u;
         if (neg) bits |= (1u << 31);
         value = bits_to_float(bits);
-        return {p + 3, fp_ok};
+        end = p + 8;
+        return true;
       }
-      if ((last - p) >= 8 && ascii_ieq8(p, "infinity")) {
+      if ((last - p) >= 3 && ascii_ieq3(p, "inf")) {
         u32 bits = 0x7f800000u;
         if (neg) bits |= (1u << 31);
         value = bits_to_float(bits);
-        return {p + 8, fp_ok};
+        end = p + 3;
+        return true;
       }
     }
   }
+  return false;
+}
 
-  dec64 d = parse_decimal_10_impl(p, last, neg);
-  if (d.ec != fp_ok) return {first, d.ec};
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 CHFLOAT_FORCE_INLINE int dec64_to_float_wide(const basic_dec64<CharT>& d,
+                                                                        float& value) noexcept {
+  // The table-based part of dec64_to_float. Unlike its double-based shortcuts, which rely on the
+  // mantissa having at most 10 digits, it is correct for any 64-bit mantissa.
+  if (d.mant == 0) {
+    u32 bits = 0;
+    if (d.neg) bits |= (1u << 31);
+    value = bits_to_float(bits);
+    return fp_ok;
+  }
+
+  // Range guard. Valid: [-64, 38] => after biasing by +64, valid is [0, 102].
+  if (static_cast<u32>(d.exp10 + 64) > 102u) {
+    if (d.exp10 > 38) {
+      u32 bits = 0x7f800000u;
+      if (d.neg) bits |= (1u << 31);
+      value = bits_to_float(bits);
+    } else {
+      u32 bits = 0;
+      if (d.neg) bits |= (1u << 31);
+      value = bits_to_float(bits);
+    }
+    return fp_result_out_of_range;
+  }
+
+  bin32 b = build_binary32(d.exp10, d.mant);
+  u32 bits = (static_cast<u32>(b.exp) << 23) | (b.mant & ((1u << 23) - 1u));
+  bool slow = b.undecided;
+  if (!d.exact) {
+    // Same bracketing as dec64_to_double.
+    const bin32 b1 = build_binary32(d.exp10, d.mant + 1ULL);
+    slow |= b1.undecided || b1.exp != b.exp || b1.mant != b.mant;
+  }
+  if (slow) bits = round_big_decimal<u32, 23, 127>(d, bits);
+  const int ec = (bits == 0 || bits == 0x7f800000u) ? fp_result_out_of_range : fp_ok;
+  if (d.neg) bits |= (1u << 31);
+  value = bits_to_float(bits);
+  return ec;
+}
 
-  // Very common fast paths: exact values with tiny decimal exponent.
-  // This targets short_no_exp (0..2 fractional digits, no exponent) and avoids a pow10-table load.
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 CHFLOAT_FORCE_INLINE int dec64_to_float(const basic_dec64<CharT>& d, float& value) noexcept {
+  // Converts a successfully parsed decimal (d.ec == fp_ok) to binary32. Returns an fp_ec value.
+  // Fast paths for exact inputs with a tiny decimal exponent (short_no_exp), each correctly
+  // rounded for binary32:
+  // - e == 0: the u64 -> float conversion rounds once.
+  // - e in [-2, -1] and mant <= 99999999: mant and 10^-e are exact in binary64, and the rounded
+  //   division followed by the cast to float gives the correctly rounded float (checked
+  //   exhaustively for every such mant; it also holds for |e| <= 10, but a wider window costs
+  //   mixed inputs more in branch misses than the table path it would save).
+  // Everything else goes to the table path.
   if (d.exact) {
     const i32 e = d.exp10;
     // Fast reject for mixed: most exponents are not in [-2,0].
@@ -895,61 +1751,519 @@ static inline fp_chars_result parse_fp_float(const char* first, const char* last
         float vf = static_cast<float>(d.mant);
         if (d.neg) vf = -vf;
         value = vf;
-        return {d.ptr, fp_ok};
+        return fp_ok;
       }
-      if (e == -1) {
-        double vd = static_cast<double>(d.mant) / 10.0;
+      if (d.mant <= 99999999ULL) {
+        const double vd = static_cast<double>(d.mant) / ((e == -1) ? 10.0 : 100.0);
         float vf = static_cast<float>(vd);
         if (d.neg) vf = -vf;
         value = vf;
-        return {d.ptr, fp_ok};
+        return fp_ok;
       }
-      // e == -2
-      double vd = static_cast<double>(d.mant) / 100.0;
-      float vf = static_cast<float>(vd);
-      if (d.neg) vf = -vf;
-      value = vf;
-      return {d.ptr, fp_ok};
     }
   }
 
-  // Fast path for exact bounded-decimal inputs.
-  // For mixed: exp10 is typically within [-30,30] and mant has <=10 digits, so this avoids
-  // the expensive pow5-table conversion most of the time.
-  if (d.exact && d.exp10 >= -38 && d.exp10 <= 38) {
-    double vd = static_cast<double>(d.mant) * pow10d_i32(d.exp10);
-    float vf = static_cast<float>(vd);
-    if (d.neg) vf = -vf;
-    value = vf;
-    return {d.ptr, fp_ok};
+  return dec64_to_float_wide(d, value);
+}
+
+template <int Fmt = fp_fmt_general, bool Padded = false, class CharT>
+static CHFLOAT_CONSTEXPR20 inline basic_fp_chars_result<CharT> parse_fp_float(const CharT* first, const CharT* last,
+                                                                              float& value) noexcept {
+  const CharT* p = first;
+  bool neg = false;
+  if (p < last && (*p == '-' || *p == '+')) {
+    neg = (*p == '-');
+    ++p;
+  }
+
+  const CharT* end = p;
+  if (parse_special_float(p, last, neg, value, end)) return {end, fp_ok};
+
+  basic_dec64<CharT> d = parse_decimal_10_impl<Fmt, Padded>(p, last, neg);
+  if (d.ec != fp_ok) return {first, d.ec};
+  return {d.ptr, dec64_to_float(d, value)};
+}
+
+// JSON numbers (fp_fmt_json): only '-' as a sign, no nan/inf, and malformed numbers ("01",
+// "1.", ".5", "1e+") are errors instead of a shorter match. Whatever follows the number is
+// left to the caller. integer: the literal had neither a fraction nor an exponent.
+template <class CharT>
+struct basic_fp_json_result {
+  const CharT* ptr;
+  int ec;
+  bool integer;
+};
+
+using fp_json_result = basic_fp_json_result<char>;
+
+template <class T, class CharT>
+static CHFLOAT_CONSTEXPR20 inline basic_fp_json_result<CharT> parse_fp_json(const CharT* first, const CharT* last,
+                                                                            T& value) noexcept {
+  static_assert(sizeof(T) == 8 || sizeof(T) == 4, "double or float");
+  const CharT* p = first;
+  bool neg = false;
+  if (p < last && *p == '-') {
+    neg = true;
+    ++p;
+  }
+  int ec;
+  basic_dec64<CharT> d;
+  if constexpr (sizeof(T) == 8) {
+    d = parse_decimal_19_impl<fp_fmt_json>(p, last, neg);
+    if (d.ec != fp_ok) return {first, d.ec, false};
+    ec = dec64_to_double(d, value);
+  } else {
+    d = parse_decimal_10_impl<fp_fmt_json>(p, last, neg);
+    if (d.ec != fp_ok) return {first, d.ec, false};
+    ec = dec64_to_float(d, value);
+  }
+  return {d.ptr, ec, d.integer};
+}
+
+// Scaled integers: round(x * 10^scale) straight from the decimal mantissa, with no binary
+// floating-point step in between. Rounding is to nearest, ties to even.
+struct fp_scaled_result {
+  const char* ptr;
+  int ec;
+  bool exact; // no rounding was needed
+};
+
+static inline int compare_dropped_half(const char* p, const char* last, int kept) noexcept {
+  // [p, last) are the digits (and '.') that produced a mantissa of `kept` significant digits
+  // with non-zero digits dropped after it. Returns the sign of (dropped part - half a unit).
+  int sig = 0;
+  for (; p < last; ++p) {
+    if (*p == '.') continue;
+    if (!is_digit(*p)) break;
+    if (sig == 0 && *p == '0') continue;
+    if (sig++ < kept) continue;
+    if (*p != '5') return (*p > '5') ? 1 : -1;
+    // Exactly '5': the tie breaks upward on any later non-zero digit.
+    for (++p; p < last; ++p) {
+      if (*p == '.') continue;
+      if (!is_digit(*p)) break;
+      if (*p != '0') return 1;
+    }
+    return 0;
+  }
+  return -1;
+}
+
+static inline fp_scaled_result parse_scaled_i64(const char* first, const char* last, i64& value,
+                                                int scale) noexcept {
+  const char* p = first;
+  bool neg = false;
+  if (p < last && (*p == '-' || *p == '+')) {
+    neg = (*p == '-');
+    ++p;
   }
 
+  dec64 d = parse_decimal_19_impl(p, last, neg);
+  if (d.ec != fp_ok) return {first, d.ec, false};
+
+  // x = mant * 10^exp10 (+ dropped digits when !exact), so x * 10^scale = mant * 10^e.
+  const u64 limit = neg ? (1ULL << 63) : (1ULL << 63) - 1;
+  const i64 e = static_cast<i64>(d.exp10) + scale;
+  u64 q = 0;
+  int half = -1; // sign of (remainder - half a unit)
+  bool exact = d.exact;
   if (d.mant == 0) {
-    u32 bits = 0;
-    if (d.neg) bits |= (1u << 31);
-    value = bits_to_float(bits);
-    return {d.ptr, fp_ok};
+    // Zero, whatever the exponent.
+  } else if (e >= 0) {
+    // A truncated mantissa holds 19 digits, so e > 0 is out of range anyway.
+    if (e > 19 || d.mant > limit / pow10_u64(static_cast<i32>(e))) return {d.ptr, fp_result_out_of_range, false};
+    q = d.mant * pow10_u64(static_cast<i32>(e));
+    if (!d.exact) half = compare_dropped_half(d.digits, d.ptr, 19);
+  } else if (e >= -19) {
+    const u64 div = pow10_u64(static_cast<i32>(-e));
+    q = d.mant / div;
+    const u64 rem = d.mant % div;
+    const u64 h = div / 2;
+    half = (rem > h) ? 1 : (rem < h) ? -1 : d.exact ? 0 : 1;
+    exact = exact && rem == 0;
+  } else {
+    // Below half a unit: mant < 10^19 <= 5 * 10^(-e - 1).
+    exact = false;
   }
 
-  // Range guard. Valid: [-64, 38] => after biasing by +64, valid is [0, 102].
-  if (static_cast<u32>(d.exp10 + 64) > 102u) {
-    if (d.exp10 > 38) {
-      u32 bits = 0x7f800000u;
-      if (d.neg) bits |= (1u << 31);
-      value = bits_to_float(bits);
+  if (half > 0 || (half == 0 && (q & 1) != 0)) ++q;
+  if (q > limit) return {d.ptr, fp_result_out_of_range, false};
+  value = neg ? static_cast<i64>(0 - q) : static_cast<i64>(q);
+  return {d.ptr, fp_ok, exact};
+}
+
+// Hexadecimal floats (chars_format::hex): [0x|0X] hexdigits [. hexdigits] [p|P [sign] digits],
+// the shape printed by %a. The optional prefix is only taken when a hex digit follows it, so
+// "0x" alone parses as 0 and stops at 'x'. Up to 16 significant nibbles go straight into a
+// 64-bit mantissa (later ones only leave a sticky bit), so the value is m * 2^e exactly and
+// the one rounding step is the final shift to the target precision.
+
+template <class Bits, int MantBits, int Bias>
+static CHFLOAT_CONSTEXPR20 inline int round_hex_mantissa(u64 mant, i32 exp2, bool sticky, Bits& bits) noexcept {
+  // bits = round-to-nearest-even of (mant + sticky) * 2^exp2, without sign. Returns an fp_ec:
+  // out of range when the value overflows or a non-zero input rounds to zero.
+  constexpr Bits inf = Bits((Bits(1) << (sizeof(Bits) * 8 - 1 - MantBits)) - 1) << MantBits;
+  if (mant == 0) {
+    bits = 0;
+    return fp_ok;
+  }
+  const i32 msb = 63 - lz64(mant);
+  if (exp2 > Bias + 256) {
+    bits = inf;
+    return fp_result_out_of_range;
+  }
+  if (exp2 < -Bias - 256 - 64) {
+    bits = 0;
+    return fp_result_out_of_range;
+  }
+  // Exponent of the last kept bit: MantBits below the leading one, but never below the
+  // subnormal quantum 2^(1 - Bias - MantBits).
+  i32 lsb = msb + exp2 - MantBits;
+  if (lsb < 1 - Bias - MantBits) lsb = 1 - Bias - MantBits;
+  const i32 shift = lsb - exp2;
+
+  u64 m;
+  if (shift <= 0) {
+    m = mant << -shift; // msb - shift <= MantBits: no bits are lost
+  } else if (shift > 64) {
+    m = 0; // below half the quantum
+  } else {
+    const u64 kept = (shift == 64) ? 0 : (mant >> shift);
+    const u64 half = 1ULL << (shift - 1);
+    const u64 rest = (shift == 64) ? mant : (mant & ((half << 1) - 1));
+    m = kept;
+    if (rest > half || (rest == half && (sticky || (kept & 1)))) ++m;
+  }
+  if (m >> (MantBits + 1)) {
+    m >>= 1;
+    ++lsb;
+  }
+  if (m == 0) {
+    bits = 0;
+    return fp_result_out_of_range;
+  }
+  if ((m >> MantBits) == 0) {
+    bits = static_cast<Bits>(m); // subnormal
+    return fp_ok;
+  }
+  const i32 be = lsb + Bias + MantBits;
+  if (be >= static_cast<i32>(inf >> MantBits)) {
+    bits = inf;
+    return fp_result_out_of_range;
+  }
+  bits = static_cast<Bits>((static_cast<Bits>(be) << MantBits) | (static_cast<Bits>(m) & ((Bits(1) << MantBits) - 1)));
+  return fp_ok;
+}
+
+template <class Bits, int MantBits, int Bias, class CharT>
+static CHFLOAT_CONSTEXPR20 inline basic_fp_chars_result<CharT> parse_hex_bits(const CharT* p, const CharT* last,
+                                                                              Bits& bits) noexcept {
+  // p points past the optional sign. On success bits holds the unsigned result.
+  const CharT* const start = p;
+  if ((last - p) >= 3 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+    const unsigned d2 = digit_in_base36(p[2]);
+    if (d2 < 16 || (p[2] == '.' && (last - p) >= 4 && digit_in_base36(p[3]) < 16)) p += 2;
+  }
+
+  u64 mant = 0;
+  int nibbles = 0;
+  i32 exp2 = 0;
+  bool sticky = false;
+  bool any = false;
+  for (; p < last; ++p) {
+    const unsigned d = digit_in_base36(*p);
+    if (d >= 16) break;
+    any = true;
+    if (nibbles < 16) {
+      mant = (mant << 4) | d;
+      nibbles += (mant != 0);
     } else {
-      u32 bits = 0;
-      if (d.neg) bits |= (1u << 31);
-      value = bits_to_float(bits);
+      exp2 += 4;
+      sticky |= (d != 0);
     }
-    return {d.ptr, fp_result_out_of_range};
   }
+  if (p < last && *p == '.') {
+    ++p;
+    for (; p < last; ++p) {
+      const unsigned d = digit_in_base36(*p);
+      if (d >= 16) break;
+      any = true;
+      if (nibbles < 16) {
+        mant = (mant << 4) | d;
+        nibbles += (mant != 0);
+        exp2 -= 4;
+      } else {
+        sticky |= (d != 0);
+      }
+    }
+  }
+  if (!any) return {start, fp_invalid_argument};
+  if (p < last && (*p == 'p' || *p == 'P')) p = parse_exponent(p, last, exp2);
 
-  bin32 b = build_binary32(d.exp10, d.mant);
-  u32 bits = (static_cast<u32>(b.exp) << 23) | (b.mant & ((1u << 23) - 1u));
-  if (d.neg) bits |= (1u << 31);
+  return {p, round_hex_mantissa<Bits, MantBits, Bias>(mant, exp2, sticky, bits)};
+}
+
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 inline basic_fp_chars_result<CharT> parse_fp_hex_double(const CharT* first,
+                                                                                   const CharT* last,
+                                                                                   double& value) noexcept {
+  const CharT* p = first;
+  bool neg = false;
+  if (p < last && (*p == '-' || *p == '+')) {
+    neg = (*p == '-');
+    ++p;
+  }
+
+  const CharT* end = p;
+  if (parse_special_double(p, last, neg, value, end)) return {end, fp_ok};
+
+  u64 bits = 0;
+  basic_fp_chars_result<CharT> r = parse_hex_bits<u64, 52, 1023>(p, last, bits);
+  if (r.ec == fp_invalid_argument) return {first, r.ec};
+  if (neg) bits |= (1ULL << 63);
+  value = bits_to_double(bits);
+  return r;
+}
+
+template <class CharT>
+static CHFLOAT_CONSTEXPR20 inline basic_fp_chars_result<CharT> parse_fp_hex_float(const CharT* first,
+                                                                                  const CharT* last,
+                                                                                  float& value) noexcept {
+  const CharT* p = first;
+  bool neg = false;
+  if (p < last && (*p == '-' || *p == '+')) {
+    neg = (*p == '-');
+    ++p;
+  }
+
+  const CharT* end = p;
+  if (parse_special_float(p, last, neg, value, end)) return {end, fp_ok};
+
+  u32 bits = 0;
+  basic_fp_chars_result<CharT> r = parse_hex_bits<u32, 23, 127>(p, last, bits);
+  if (r.ec == fp_invalid_argument) return {first, r.ec};
+  if (neg) bits |= (1u << 31);
   value = bits_to_float(bits);
-  return {d.ptr, fp_ok};
+  return r;
+}
+
+// Validation only: the grammars of parse_fp_double / parse_fp_hex_double, walked with the
+// same digit-run scanners but without accumulating a mantissa or an exponent and without
+// touching the pow5 tables. Each skip_* helper returns the end of what it matched, or nullptr
+// when there is no number.
+
+static inline const char* skip_exponent(const char* p, const char* last) noexcept {
+  // Same contract as parse_exponent: p points at the marker; returns p when no digits follow.
+  const char* q = p + 1;
+  if (q < last && (*q == '-' || *q == '+')) ++q;
+  if (q == last || !is_digit(*q)) return p;
+  return digit_run_end(q, last);
+}
+
+static inline const char* skip_special(const char* p, const char* last) noexcept {
+  // nan/inf/infinity, as in parse_special_double.
+  if ((last - p) >= 3) {
+    if (ascii_ieq3(p, "nan")) return p + 3;
+    if (ascii_ieq3(p, "inf")) return ((last - p) >= 8 && ascii_ieq8(p, "infinity")) ? p + 8 : p + 3;
+  }
+  return nullptr;
+}
+
+template <int Fmt>
+static inline const char* skip_decimal(const char* p, const char* last) noexcept {
+  // The grammar of parse_decimal_n_impl.
+  const char* const start = p;
+  const char* int_end = p;
+  const char* frac_end = nullptr;
+  locate_digit_runs(p, last, int_end, frac_end);
+  bool any = (int_end != p);
+  p = int_end;
+  if (frac_end != nullptr) {
+    any |= (frac_end != int_end + 1);
+    p = frac_end;
+  }
+  if (!any) return nullptr;
+
+  if constexpr (Fmt == fp_fmt_json) {
+    const usize int_len = static_cast<usize>(int_end - start);
+    if (int_len == 0 || (int_len > 1 && *start == '0') || (frac_end == int_end + 1)) return nullptr;
+  }
+
+  if constexpr (Fmt == fp_fmt_scientific) {
+    const char* q = (p < last && (*p == 'e' || *p == 'E')) ? skip_exponent(p, last) : p;
+    return (q == p) ? nullptr : q;
+  } else if constexpr (Fmt == fp_fmt_general) {
+    if (p < last && (*p == 'e' || *p == 'E')) p = skip_exponent(p, last);
+  } else if constexpr (Fmt == fp_fmt_json) {
+    if (p < last && (*p == 'e' || *p == 'E')) {
+      const char* q = skip_exponent(p, last);
+      if (q == p) return nullptr;
+      p = q;
+    }
+  }
+  return p;
+}
+
+static inline const char* skip_hex_digits(const char* p, const char* last) noexcept {
+  while (p < last && digit_in_base36(*p) < 16) ++p;
+  return p;
+}
+
+static inline const char* skip_hex(const char* p, const char* last) noexcept {
+  // The grammar of parse_hex_bits, including its rule for the optional 0x prefix.
+  if ((last - p) >= 3 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+    const unsigned d2 = digit_in_base36(p[2]);
+    if (d2 < 16 || (p[2] == '.' && (last - p) >= 4 && digit_in_base36(p[3]) < 16)) p += 2;
+  }
+  const char* q = skip_hex_digits(p, last);
+  bool any = (q != p);
+  if (q < last && *q == '.') {
+    const char* f = q + 1;
+    q = skip_hex_digits(f, last);
+    any |= (q != f);
+  }
+  if (!any) return nullptr;
+  if (q < last && (*q == 'p' || *q == 'P')) q = skip_exponent(q, last);
+  return q;
+}
+
+// ptr/ec as parse_fp_double<Fmt> (parse_fp_hex_double / parse_fp_json for fp_fmt_hex /
+// fp_fmt_json) would return, except that the value is never computed: out-of-range inputs
+// are fp_ok here.
+template <int Fmt = fp_fmt_general>
+static inline fp_chars_result validate_fp(const char* first, const char* last) noexcept {
+  const char* p = first;
+  const char* end = nullptr;
+  if constexpr (Fmt == fp_fmt_json) {
+    if (p < last && *p == '-') ++p;
+    end = skip_decimal<Fmt>(p, last);
+  } else {
+    if (p < last && (*p == '-' || *p == '+')) ++p;
+    end = skip_special(p, last);
+    if (end == nullptr) {
+      if constexpr (Fmt == fp_fmt_hex) {
+        end = skip_hex(p, last);
+      } else {
+        end = skip_decimal<Fmt>(p, last);
+      }
+    }
+  }
+  if (end == nullptr) return {first, fp_invalid_argument};
+  return {end, fp_ok};
+}
+
+// Batch parsing: a run of numbers separated by single separator bytes.
+//
+// Parses until `last`, until `cap` values have been stored, or until the first bad token.
+// On success ptr is where parsing stopped (last, or the start of the next token when cap
+// was reached). On error ptr is the start of the offending token and count is the number of
+// values stored before it. A trailing separator before `last` is accepted.
+
+struct fp_many_result {
+  const char* ptr;
+  usize count;
+  int ec;
+};
+
+static inline int parse_fp_token(const char* p, const char* last, bool neg, double& value,
+                                 const char*& end) noexcept {
+  dec64 d = parse_decimal_19_impl(p, last, neg);
+  if (d.ec != fp_ok) return d.ec;
+  end = d.ptr;
+  return dec64_to_double(d, value);
+}
+
+static inline int parse_fp_token(const char* p, const char* last, bool neg, float& value,
+                                 const char*& end) noexcept {
+  dec64 d = parse_decimal_10_impl(p, last, neg);
+  if (d.ec != fp_ok) return d.ec;
+  end = d.ptr;
+  return dec64_to_float(d, value);
+}
+
+static inline bool parse_special(const char* p, const char* last, bool neg, double& value,
+                                 const char*& end) noexcept {
+  return parse_special_double(p, last, neg, value, end);
+}
+
+static inline bool parse_special(const char* p, const char* last, bool neg, float& value,
+                                 const char*& end) noexcept {
+  return parse_special_float(p, last, neg, value, end);
+}
+
+template <class T, class IsSep>
+static inline fp_many_result parse_fp_many(const char* first, const char* last, IsSep is_sep, T* out,
+                                           usize cap) noexcept {
+  const char* p = first;
+  usize n = 0;
+  while (p < last && n < cap) {
+    const char* tok = p;
+    bool neg = false;
+    if (*p == '-' || *p == '+') {
+      neg = (*p == '-');
+      ++p;
+    }
+
+    T v;
+    const char* end = p;
+    // Numbers start with a digit or '.', so the specials check only runs for other bytes.
+    if (p < last && (is_digit(*p) || *p == '.')) {
+      const int ec = parse_fp_token(p, last, neg, v, end);
+      if (ec != fp_ok) return {tok, n, ec};
+    } else if (!parse_special(p, last, neg, v, end)) {
+      return {tok, n, fp_invalid_argument};
+    }
+
+    p = end;
+    if (p < last) {
+      if (!is_sep(*p)) return {tok, n, fp_invalid_argument};
+      ++p;
+    }
+    out[n++] = v;
+  }
+  return {p, n, fp_ok};
+}
+
+struct fp_single_sep {
+  char c;
+  bool operator()(char x) const noexcept { return x == c; }
+};
+
+#if CHFLOAT_DISPATCH_X86
+// The whole batch loop recompiled for AVX2/BMI2 hosts: flatten pulls every helper into the
+// clone, so the multiplies become MULX, bit scans TZCNT and shifts SHLX/SHRX.
+template <class T>
+static CHFLOAT_TARGET_AVX2 __attribute__((flatten, noinline)) fp_many_result
+parse_fp_many_avx2(const char* first, const char* last, char sep, T* out, usize cap) noexcept {
+  return parse_fp_many(first, last, fp_single_sep{sep}, out, cap);
+}
+#endif
+
+static inline fp_many_result parse_fp_double_many(const char* first, const char* last, char sep, double* out,
+                                                  usize cap) noexcept {
+#if CHFLOAT_DISPATCH_X86
+  if (host_cpu.avx2_bmi2) return parse_fp_many_avx2(first, last, sep, out, cap);
+#endif
+  return parse_fp_many(first, last, fp_single_sep{sep}, out, cap);
+}
+
+static inline fp_many_result parse_fp_float_many(const char* first, const char* last, char sep, float* out,
+                                                 usize cap) noexcept {
+#if CHFLOAT_DISPATCH_X86
+  if (host_cpu.avx2_bmi2) return parse_fp_many_avx2(first, last, sep, out, cap);
+#endif
+  return parse_fp_many(first, last, fp_single_sep{sep}, out, cap);
+}
+
+// The two entry points above, for callers templated on the value type.
+static inline fp_many_result parse_fp_sep_many(const char* first, const char* last, char sep, double* out,
+                                               usize cap) noexcept {
+  return parse_fp_double_many(first, last, sep, out, cap);
+}
+
+static inline fp_many_result parse_fp_sep_many(const char* first, const char* last, char sep, float* out,
+                                               usize cap) noexcept {
+  return parse_fp_float_many(first, last, sep, out, cap);
 }
 
 } // namespace detail
@@ -1,8 +1,9 @@
 #pragma once
 
-// Generated by chfloat/script/gen_pow5_table.py on 2026-01-06 UTC
-// Cached 128-bit representations of 5^q for q in [-342, 308].
+// Generated by chfloat/script/gen_pow5_table.py on 2026-10-14 UTC
+// Cached 128-bit representations of 5^q for q in [-342, 324].
 // Table layout: entry i corresponds to q = smallest_q + i.
+// CHFLOAT_COMPACT_POW5 selects the compact form; read entries through pow5_entry().
 
 
 namespace chfloat {
@@ -11,7 +12,206 @@ namespace detail {
 struct alignas(16) pow5_128 { unsigned long long hi; unsigned long long lo; };
 
 inline constexpr int pow5_smallest_q = -342;
-inline constexpr int pow5_largest_q = 308;
+inline constexpr int pow5_largest_q = 324;
+
+// binary32 only: 64-bit truncated 5^q, normalized to [2^63, 2^64).
+inline constexpr int pow5_float_smallest_q = -64;
+inline constexpr int pow5_float_largest_q = 38;
+alignas(64) inline constexpr unsigned long long pow5_float_table[] = {
+  0xa87fea27a539e9a5ULL,
+  0xd29fe4b18e88640eULL,
+  0x83a3eeeef9153e89ULL,
+  0xa48ceaaab75a8e2bULL,
+  0xcdb02555653131b6ULL,
+  0x808e17555f3ebf11ULL,
+  0xa0b19d2ab70e6ed6ULL,
+  0xc8de047564d20a8bULL,
+  0xfb158592be068d2eULL,
+  0x9ced737bb6c4183dULL,
+  0xc428d05aa4751e4cULL,
+  0xf53304714d9265dfULL,
+  0x993fe2c6d07b7fabULL,
+  0xbf8fdb78849a5f96ULL,
+  0xef73d256a5c0f77cULL,
+  0x95a8637627989aadULL,
+  0xbb127c53b17ec159ULL,
+  0xe9d71b689dde71afULL,
+  0x9226712162ab070dULL,
+  0xb6b00d69bb55c8d1ULL,
+  0xe45c10c42a2b3b05ULL,
+  0x8eb98a7a9a5b04e3ULL,
+  0xb267ed1940f1c61cULL,
+  0xdf01e85f912e37a3ULL,
+  0x8b61313bbabce2c6ULL,
+  0xae397d8aa96c1b77ULL,
+  0xd9c7dced53c72255ULL,
+  0x881cea14545c7575ULL,
+  0xaa242499697392d2ULL,
+  0xd4ad2dbfc3d07787ULL,
+  0x84ec3c97da624ab4ULL,
+  0xa6274bbdd0fadd61ULL,
+  0xcfb11ead453994baULL,
+  0x81ceb32c4b43fcf4ULL,
+  0xa2425ff75e14fc31ULL,
+  0xcad2f7f5359a3b3eULL,
+  0xfd87b5f28300ca0dULL,
+  0x9e74d1b791e07e48ULL,
+  0xc612062576589ddaULL,
+  0xf79687aed3eec551ULL,
+  0x9abe14cd44753b52ULL,
+  0xc16d9a0095928a27ULL,
+  0xf1c90080baf72cb1ULL,
+  0x971da05074da7beeULL,
+  0xbce5086492111aeaULL,
+  0xec1e4a7db69561a5ULL,
+  0x9392ee8e921d5d07ULL,
+  0xb877aa3236a4b449ULL,
+  0xe69594bec44de15bULL,
+  0x901d7cf73ab0acd9ULL,
+  0xb424dc35095cd80fULL,
+  0xe12e13424bb40e13ULL,
+  0x8cbccc096f5088cbULL,
+  0xafebff0bcb24aafeULL,
+  0xdbe6fecebdedd5beULL,
+  0x89705f4136b4a597ULL,
+  0xabcc77118461cefcULL,
+  0xd6bf94d5e57a42bcULL,
+  0x8637bd05af6c69b5ULL,
+  0xa7c5ac471b478423ULL,
+  0xd1b71758e219652bULL,
+  0x83126e978d4fdf3bULL,
+  0xa3d70a3d70a3d70aULL,
+  0xccccccccccccccccULL,
+  0x8000000000000000ULL,
+  0xa000000000000000ULL,
+  0xc800000000000000ULL,
+  0xfa00000000000000ULL,
+  0x9c40000000000000ULL,
+  0xc350000000000000ULL,
+  0xf424000000000000ULL,
+  0x9896800000000000ULL,
+  0xbebc200000000000ULL,
+  0xee6b280000000000ULL,
+  0x9502f90000000000ULL,
+  0xba43b74000000000ULL,
+  0xe8d4a51000000000ULL,
+  0x9184e72a00000000ULL,
+  0xb5e620f480000000ULL,
+  0xe35fa931a0000000ULL,
+  0x8e1bc9bf04000000ULL,
+  0xb1a2bc2ec5000000ULL,
+  0xde0b6b3a76400000ULL,
+  0x8ac7230489e80000ULL,
+  0xad78ebc5ac620000ULL,
+  0xd8d726b7177a8000ULL,
+  0x878678326eac9000ULL,
+  0xa968163f0a57b400ULL,
+  0xd3c21bcecceda100ULL,
+  0x84595161401484a0ULL,
+  0xa56fa5b99019a5c8ULL,
+  0xcecb8f27f4200f3aULL,
+  0x813f3978f8940984ULL,
+  0xa18f07d736b90be5ULL,
+  0xc9f2c9cd04674edeULL,
+  0xfc6f7c4045812296ULL,
+  0x9dc5ada82b70b59dULL,
+  0xc5371912364ce305ULL,
+  0xf684df56c3e01bc6ULL,
+  0x9a130b963a6c115cULL,
+  0xc097ce7bc90715b3ULL,
+  0xf0bdc21abb48db20ULL,
+  0x96769950b50d88f4ULL,
+};
+
+#if defined(CHFLOAT_COMPACT_POW5)
+
+// Entry i = top 128 bits of pow5_compact_base[i / step] * pow5_small[i % step]
+//           + ((pow5_compact_fix[i / 32] >> (2 * (i % 32))) & 3).
+inline constexpr int pow5_compact_step = 28;
+alignas(64) inline constexpr pow5_128 pow5_compact_base[] = {
+  { 0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL },
+  { 0xf148440a256e2c76ULL, 0xc00670ea43ca250dULL },
+  { 0xf3a20279ed56d48aULL, 0x6b43527578c1110fULL },
+  { 0xf6019da07f549b2bULL, 0x7e2a53a146606a48ULL },
+  { 0xf867241c8cc6d4c0ULL, 0xc30163d203c94b62ULL },
+  { 0xfad2a4b13d1b5d6cULL, 0x796b805720085f81ULL },
+  { 0xfd442e4688bd304aULL, 0x908f4a166d1da663ULL },
+  { 0xffbbcfe994e5c61fULL, 0xfdf17746497f7052ULL },
+  { 0x811ccc668829b887ULL, 0x0806357d5a3f525fULL },
+  { 0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL },
+  { 0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL },
+  { 0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL },
+  { 0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL },
+  { 0x878678326eac9000ULL, 0x0000000000000000ULL },
+  { 0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL },
+  { 0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL },
+  { 0x8b865b215899f46cULL, 0xbd79e0d20082ee74ULL },
+  { 0x8ce2529e2734bb1dULL, 0x1899e4a65f58660cULL },
+  { 0x8e41ade9fbebc27dULL, 0x14588f13be847307ULL },
+  { 0x8fa475791a569d10ULL, 0xf96e017d694487bcULL },
+  { 0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a2ULL },
+  { 0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb4ULL },
+  { 0x93e1ab8252f33b45ULL, 0xcabb90e5c942b503ULL },
+  { 0x95527a5202df0ccbULL, 0x0f37801e0c43ebc8ULL },
+};
+alignas(64) inline constexpr unsigned long long pow5_small[] = {
+  0x0000000000000001ULL,
+  0x0000000000000005ULL,
+  0x0000000000000019ULL,
+  0x000000000000007dULL,
+  0x0000000000000271ULL,
+  0x0000000000000c35ULL,
+  0x0000000000003d09ULL,
+  0x000000000001312dULL,
+  0x000000000005f5e1ULL,
+  0x00000000001dcd65ULL,
+  0x00000000009502f9ULL,
+  0x0000000002e90eddULL,
+  0x000000000e8d4a51ULL,
+  0x0000000048c27395ULL,
+  0x000000016bcc41e9ULL,
+  0x000000071afd498dULL,
+  0x0000002386f26fc1ULL,
+  0x000000b1a2bc2ec5ULL,
+  0x000003782dace9d9ULL,
+  0x00001158e460913dULL,
+  0x000056bc75e2d631ULL,
+  0x0001b1ae4d6e2ef5ULL,
+  0x000878678326eac9ULL,
+  0x002a5a058fc295edULL,
+  0x00d3c21bcecceda1ULL,
+  0x0422ca8b0a00a425ULL,
+  0x14adf4b7320334b9ULL,
+  0x6765c793fa10079dULL,
+};
+inline constexpr unsigned long long pow5_compact_fix[] = {
+  0x0045101015155440ULL,
+  0x0000000000050000ULL,
+  0x4010000000001001ULL,
+  0x0000000004504101ULL,
+  0x1040110040010050ULL,
+  0x0010004001044005ULL,
+  0x0545444050140000ULL,
+  0x9051556955455554ULL,
+  0x0550955565955965ULL,
+  0xaa95644114051514ULL,
+  0x00000040a79aaaeaULL,
+  0x0000000000000000ULL,
+  0x0000000000000000ULL,
+  0x0140105000141000ULL,
+  0x5040155504440500ULL,
+  0x0010555514545511ULL,
+  0x9556641000110100ULL,
+  0x44150504955555a5ULL,
+  0x5465515550155514ULL,
+  0x4000000500405555ULL,
+  0x0015555051511041ULL,
+};
+inline constexpr decltype(sizeof(0)) pow5_table_bytes =
+    sizeof(pow5_compact_base) + sizeof(pow5_small) + sizeof(pow5_compact_fix);
+
+#else
+
 alignas(64) inline constexpr pow5_128 pow5_table[] = {
   { 0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL },
   { 0x9558b4661b6565f8ULL, 0x4ac7ca59a424c507ULL },
@@ -664,7 +864,26 @@ alignas(64) inline constexpr pow5_128 pow5_table[] = {
   { 0xb6472e511c81471dULL, 0xe0133fe4adf8e952ULL },
   { 0xe3d8f9e563a198e5ULL, 0x58180fddd97723a6ULL },
   { 0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7648ULL },
+  { 0xb201833b35d63f73ULL, 0x2cd2cc6551e513daULL },
+  { 0xde81e40a034bcf4fULL, 0xf8077f7ea65e58d1ULL },
+  { 0x8b112e86420f6191ULL, 0xfb04afaf27faf782ULL },
+  { 0xadd57a27d29339f6ULL, 0x79c5db9af1f9b563ULL },
+  { 0xd94ad8b1c7380874ULL, 0x18375281ae7822bcULL },
+  { 0x87cec76f1c830548ULL, 0x8f2293910d0b15b5ULL },
+  { 0xa9c2794ae3a3c69aULL, 0xb2eb3875504ddb22ULL },
+  { 0xd433179d9c8cb841ULL, 0x5fa60692a46151ebULL },
+  { 0x849feec281d7f328ULL, 0xdbc7c41ba6bcd333ULL },
+  { 0xa5c7ea73224deff3ULL, 0x12b9b522906c0800ULL },
+  { 0xcf39e50feae16befULL, 0xd768226b34870a00ULL },
+  { 0x81842f29f2cce375ULL, 0xe6a1158300d46640ULL },
+  { 0xa1e53af46f801c53ULL, 0x60495ae3c1097fd0ULL },
+  { 0xca5e89b18b602368ULL, 0x385bb19cb14bdfc4ULL },
+  { 0xfcf62c1dee382c42ULL, 0x46729e03dd9ed7b5ULL },
+  { 0x9e19db92b4e31ba9ULL, 0x6c07a2c26a8346d1ULL },
 };
+inline constexpr decltype(sizeof(0)) pow5_table_bytes = sizeof(pow5_table);
+
+#endif
 
 } // namespace detail
 } // namespace chfloat
@@ -0,0 +1,125 @@
+
+#pragma once
+
+// chfloat/parallel.h: multithreaded from_chars_many for large in-memory buffers.
+// Optional add-on to chfloat.h; unlike the core it uses <thread> and allocates per-task state.
+//
+// The input is cut into slices that each end just past a delimiter, so no token straddles two
+// slices. A first parallel pass counts the tokens of every slice, a prefix sum turns the counts
+// into output offsets, and a second parallel pass parses every slice straight into its part of
+// the caller's array. The result is the same as a single from_chars_many call.
+
+#include <chfloat/chfloat.h>
+
+#include <thread>
+#include <vector>
+
+namespace chfloat {
+
+// Default executor: runs task(0) .. task(n - 1) on n - 1 new threads plus the calling thread
+// and returns once all of them have finished.
+//
+// Any callable with the same shape can be passed instead to run the tasks on an existing pool:
+//   void operator()(unsigned n, Task&& task) const;   // task(i) for every i in [0, n), then join
+struct thread_executor {
+  template <class Task>
+  void operator()(unsigned n, Task&& task) const {
+    std::vector<std::thread> workers;
+    workers.reserve(n);
+    unsigned i = 1;
+    for (; i < n; ++i) {
+      try {
+        workers.emplace_back([&task, i] { task(i); });
+      } catch (...) {
+        break; // out of threads: finish the remaining tasks here
+      }
+    }
+    for (; i < n; ++i) task(i);
+    task(0u);
+    for (std::thread& t : workers) t.join();
+  }
+};
+
+namespace detail {
+
+// Slices smaller than this are not worth a task of their own.
+inline constexpr usize parallel_min_slice = usize(1) << 16;
+
+inline usize count_delimiters(const char* p, const char* last, char delimiter) noexcept {
+  // Plain loop on purpose: compilers vectorize it.
+  usize n = 0;
+  for (; p < last; ++p) n += (*p == delimiter);
+  return n;
+}
+
+struct parallel_slice {
+  const char* first;
+  const char* last;
+  usize count;  // tokens in [first, last), valid when the slice parses
+  usize offset; // index of its first value in the output
+  fp_many_result result;
+};
+
+} // namespace detail
+
+// Same contract as from_chars_many (ptr/count/ec, cap, trailing delimiter), parsed with up to
+// `threads` concurrent tasks (0: std::thread::hardware_concurrency()). Inputs too small to
+// split are parsed on the calling thread. On error, out[count..cap) may hold values parsed
+// past the failing token.
+template <class T, class Executor = thread_executor>
+inline from_chars_many_result from_chars_many_parallel(const char* first, const char* last, char delimiter, T* out,
+                                                       detail::usize cap, unsigned threads = 0,
+                                                       const Executor& exec = Executor()) {
+  using detail::usize;
+  if (threads == 0) threads = std::thread::hardware_concurrency();
+  const usize len = static_cast<usize>(last - first);
+  usize n = len / detail::parallel_min_slice;
+  if (n > threads) n = threads;
+  if (n <= 1) return from_chars_many(first, last, delimiter, out, cap);
+
+  // Cut at roughly equal byte offsets, each moved forward to just past the next delimiter.
+  std::vector<detail::parallel_slice> slices(n);
+  const char* p = first;
+  for (usize i = 0; i < n; ++i) {
+    const char* q = (i + 1 == n) ? last : first + len / n * (i + 1);
+    if (q < p) q = p;
+    while (q < last && q[-1] != delimiter) ++q;
+    slices[i].first = p;
+    slices[i].last = q;
+    p = q;
+  }
+
+  // Pass 1: every delimiter ends one token, plus an unterminated last token.
+  exec(static_cast<unsigned>(n), [&](unsigned i) {
+    detail::parallel_slice& s = slices[i];
+    s.count = detail::count_delimiters(s.first, s.last, delimiter);
+    if (s.last == last && s.first != s.last && s.last[-1] != delimiter) ++s.count;
+  });
+
+  usize total = 0;
+  for (detail::parallel_slice& s : slices) {
+    s.offset = total;
+    total += s.count;
+  }
+
+  // Pass 2: slices past `cap` are skipped; the one holding the cap stops early, exactly where
+  // from_chars_many would.
+  exec(static_cast<unsigned>(n), [&](unsigned i) {
+    detail::parallel_slice& s = slices[i];
+    if (s.offset >= cap) {
+      s.result = {s.first, 0, detail::fp_ok};
+      return;
+    }
+    const usize room = cap - s.offset;
+    s.result = detail::parse_fp_sep_many(s.first, s.last, delimiter, out + s.offset,
+                                         (s.count < room) ? s.count : room);
+  });
+
+  for (const detail::parallel_slice& s : slices) {
+    const detail::fp_many_result& r = s.result;
+    if (r.ec != detail::fp_ok || r.ptr != s.last) return {r.ptr, s.offset + r.count, static_cast<errc>(r.ec)};
+  }
+  return {last, total, errc::ok};
+}
+
+} // namespace chfloat
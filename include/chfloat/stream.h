@@ -0,0 +1,204 @@
+
+#pragma once
+
+// chfloat/stream.h: chunked reader for separator-delimited numeric files.
+// Optional add-on to chfloat.h; unlike the core it uses <cstdio> and allocates its buffers.
+//
+//   chfloat::double_stream s("column.csv");           // separators default to ",\n"
+//   while (s.next() == chfloat::errc::ok && s.size() != 0) consume(s.data(), s.size());
+//
+// The file is read in large chunks straight into one reusable buffer; records are parsed in
+// place (never copied into a std::string) and the record cut by a chunk boundary is carried
+// over to the next read.
+
+#include <chfloat/chfloat.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace chfloat {
+
+struct stream_options {
+  // Every byte of this NUL-terminated set ends a record. Whitespace that is not a separator
+  // may surround a value ("1.5 ,\t2\r\n" is fine with the default set). An empty record ended
+  // by '\n' (a blank line) is skipped, as in csv.h; any other empty record is an error.
+  const char* separators = ",\n";
+  // Bytes read per chunk. A record longer than this grows the buffer instead of failing.
+  detail::usize chunk_size = detail::usize(1) << 20;
+};
+
+namespace detail {
+
+inline const char* skip_blanks(const char* p, const char* last, const bool* sep) noexcept {
+  // Like skip_leading_ascii_spaces, but a separator that is also whitespace ('\n', '\t') stays.
+  while (p < last && !sep[static_cast<unsigned char>(*p)] && is_space_ascii(static_cast<unsigned char>(*p))) ++p;
+  return p;
+}
+
+template <class T>
+inline from_chars_result parse_records(const char* p, const char* last, const bool* sep, T* out,
+                                       usize& count) noexcept {
+  // Parses "rec<sep>rec<sep>...rec" in [p, last), where rec is a value with optional blanks on
+  // either side; appends to out[count..]. A blank record ended by '\n' is skipped. On error ptr
+  // is the start of the offending record.
+  for (;;) {
+    const char* rec = p;
+    p = skip_blanks(p, last, sep);
+    if (p != last && *p == '\n') {
+      // skip_blanks only stops at '\n' when it is a separator.
+      if (++p == last) return {p, errc::ok};
+      continue;
+    }
+    T v;
+    from_chars_result r = chfloat::from_chars(p, last, v);
+    if (r.ec != errc::ok) return {rec, r.ec};
+    p = skip_blanks(r.ptr, last, sep);
+    if (p != last && !sep[static_cast<unsigned char>(*p)]) return {rec, errc::invalid_argument};
+    out[count++] = v;
+    if (p == last) return {p, errc::ok};
+    ++p;
+  }
+}
+
+} // namespace detail
+
+template <class T>
+class basic_number_stream {
+ public:
+  explicit basic_number_stream(const char* path, stream_options opt = stream_options())
+      : file_(std::fopen(path, "rb")), owns_file_(true) {
+    init(opt);
+  }
+
+  // Reads from an already open stream; the caller keeps ownership of `file`.
+  explicit basic_number_stream(std::FILE* file, stream_options opt = stream_options())
+      : file_(file), owns_file_(false) {
+    init(opt);
+  }
+
+  basic_number_stream(const basic_number_stream&) = delete;
+  basic_number_stream& operator=(const basic_number_stream&) = delete;
+
+  ~basic_number_stream() {
+    if (owns_file_ && file_ != nullptr) std::fclose(file_);
+  }
+
+  bool is_open() const noexcept { return file_ != nullptr; }
+
+  // Parses the next chunk of records into data()[0, size()).
+  //   - ok with size() == 0: end of input. Trailing separators and blanks are accepted.
+  //   - error: error_offset() is the byte offset of the offending record (or of the read
+  //     position for an unopened file / read error, reported as invalid_argument). The values
+  //     parsed before it in this chunk are still in data(); later calls keep failing.
+  errc next() {
+    size_ = 0;
+    if (ec_ != errc::ok || done_) return ec_;
+    if (file_ == nullptr) return fail(errc::invalid_argument, offset_);
+
+    // Fill until the buffer holds at least one complete record or the input ends. The cut is
+    // the separator that ends the last record; the run of separators and blanks after it is
+    // carried over, so the final trim below sees the same bytes at every chunk size. Carried
+    // bytes hold no separator preceded by a record, so only newly read bytes are searched.
+    usize have = carry_;
+    const char* cut = nullptr;
+    bool eof = false;
+    while (cut == nullptr && !eof) {
+      if (buf_.size() - have < chunk_size_) buf_.resize(have + chunk_size_);
+      const usize got = std::fread(buf_.data() + have, 1, buf_.size() - have, file_);
+      if (got < buf_.size() - have) {
+        if (std::ferror(file_)) return fail(errc::invalid_argument, offset_ + have);
+        eof = true;
+      }
+      for (const char* q = buf_.data() + have + got; q != buf_.data() + have;) {
+        --q;
+        if (sep_[static_cast<unsigned char>(*q)]) {
+          cut = q;
+          break;
+        }
+      }
+      have += got;
+      if (cut != nullptr) {
+        // Back up to the first separator after the last non-blank byte; none means the buffer
+        // holds only separators and blanks so far.
+        const char* run = cut;
+        while (run != buf_.data() && is_blank_or_sep(run[-1])) --run;
+        if (run == buf_.data()) {
+          cut = nullptr;
+        } else {
+          while (!sep_[static_cast<unsigned char>(*run)]) ++run;
+          cut = run;
+        }
+      }
+    }
+
+    const char* const first = buf_.data();
+    const char* last = buf_.data() + have;
+    if (eof) {
+      // The final region: drop trailing separators and blanks (e.g. a final newline).
+      while (last != first && is_blank_or_sep(last[-1])) --last;
+      done_ = true;
+    } else {
+      last = cut;
+    }
+
+    if (!eof || last != first) {
+      // Every record takes at least one byte plus a separator. Blank lines are skipped; any
+      // other empty record fails to parse.
+      const usize max_records = static_cast<usize>(last - first) / 2 + 1;
+      if (values_.size() < max_records) values_.resize(max_records);
+      from_chars_result r = detail::parse_records(first, last, sep_, values_.data(), size_);
+      if (r.ec != errc::ok) return fail(r.ec, offset_ + static_cast<usize>(r.ptr - first));
+    }
+
+    if (!eof) {
+      // Carry everything after the cut to the front of the buffer.
+      const usize used = static_cast<usize>(cut + 1 - first);
+      carry_ = have - used;
+      std::memmove(buf_.data(), buf_.data() + used, carry_);
+      offset_ += used;
+    }
+    return errc::ok;
+  }
+
+  const T* data() const noexcept { return values_.data(); }
+  detail::usize size() const noexcept { return size_; }
+  unsigned long long error_offset() const noexcept { return error_offset_; }
+
+ private:
+  using usize = detail::usize;
+
+  void init(const stream_options& opt) noexcept {
+    for (bool& b : sep_) b = false;
+    for (const char* s = opt.separators; s != nullptr && *s != '\0'; ++s) sep_[static_cast<unsigned char>(*s)] = true;
+    chunk_size_ = (opt.chunk_size != 0) ? opt.chunk_size : 1;
+  }
+
+  bool is_blank_or_sep(char c) const noexcept {
+    return sep_[static_cast<unsigned char>(c)] || detail::is_space_ascii(static_cast<unsigned char>(c));
+  }
+
+  errc fail(errc ec, unsigned long long offset) noexcept {
+    ec_ = ec;
+    error_offset_ = offset;
+    return ec;
+  }
+
+  std::FILE* file_;
+  bool owns_file_;
+  bool sep_[256];
+  usize chunk_size_ = 0;
+  std::vector<char> buf_;
+  std::vector<T> values_;
+  usize size_ = 0;
+  usize carry_ = 0;
+  unsigned long long offset_ = 0; // file offset of buf_[0]
+  unsigned long long error_offset_ = 0;
+  errc ec_ = errc::ok;
+  bool done_ = false;
+};
+
+using double_stream = basic_number_stream<double>;
+using float_stream = basic_number_stream<float>;
+
+} // namespace chfloat
@@ -5,15 +5,27 @@ It follows the published technique used by Eisel-Lemire style parsers:
 - For q < 0: store ceil(2^b / 5^{-q}) ("inverse powers"), with b chosen to keep 128-bit.
 - For q >= 0: store truncated 5^q scaled into [2^127, 2^128).
 
-Outputs a C++ header with a single contiguous table for q in [-342, 308].
+Outputs a C++ header with a single contiguous table for q in [-342, 324]. The parser only
+needs q <= 308; the shortest-digits formatter (to_chars) needs 10^k up to k = 324.
+
+With CHFLOAT_COMPACT_POW5 the header instead provides every COMPACT_STEP-th entry, the 64-bit
+powers 5^0 .. 5^(COMPACT_STEP - 1), and a 2-bit correction per q: the top 128 bits of
+base * 5^r, plus the correction, reproduce the full table entry bit for bit.
+
+The binary32 parser gets its own 64-bit table for q in [FLOAT_SMALLEST_Q, FLOAT_LARGEST_Q]:
+floor(5^q) normalized to [2^63, 2^64), i.e. the high word of the 128-bit entry.
 """
 
 from __future__ import annotations
 
 import datetime
+import os
 
 SMALLEST_Q = -342
-LARGEST_Q = 308
+LARGEST_Q = 324
+COMPACT_STEP = 28  # 5^27 still fits in 64 bits
+FLOAT_SMALLEST_Q = -64
+FLOAT_LARGEST_Q = 38
 
 
 def split_u128(x: int) -> tuple[int, int]:
@@ -45,7 +57,7 @@ def gen() -> list[tuple[int, int]]:
 
         out.append(split_u128(c))
 
-    # q in [0, 308]
+    # q in [0, LARGEST_Q]
     for q in range(0, LARGEST_Q + 1):
         power5 = 5 ** q
         # scale into [2^127, 2^128)
@@ -59,28 +71,102 @@ def gen() -> list[tuple[int, int]]:
     return out
 
 
+def reconstruct(base: int, r: int) -> int:
+    # Mirrors pow5_entry() in float_parse.h: top 128 bits of base * 5^r.
+    if r == 0:
+        return base
+    p = base * 5 ** r
+    return p >> (p.bit_length() - 128)
+
+
+def gen_compact(table: list[tuple[int, int]]) -> tuple[list[tuple[int, int]], list[int]]:
+    full = [(hi << 64) | lo for (hi, lo) in table]
+    bases = [table[i] for i in range(0, len(table), COMPACT_STEP)]
+    fixes = []
+    for i, entry in enumerate(full):
+        base = full[i - i % COMPACT_STEP]
+        fix = entry - reconstruct(base, i % COMPACT_STEP)
+        assert 0 <= fix <= 3
+        fixes.append(fix)
+    words = []
+    for w in range(0, len(fixes), 32):
+        word = 0
+        for j, fix in enumerate(fixes[w:w + 32]):
+            word |= fix << (2 * j)
+        words.append(word)
+    return bases, words
+
+
+def gen_float(table: list[tuple[int, int]]) -> list[int]:
+    out = []
+    for q in range(FLOAT_SMALLEST_Q, FLOAT_LARGEST_Q + 1):
+        hi = table[q - SMALLEST_Q][0]
+        # The high word must be the 64-bit truncation of 5^q (the parser bounds its error by that).
+        if q >= 0:
+            exact = 5 ** q
+            assert hi == (exact << 64 >> (exact.bit_length())) if exact.bit_length() <= 64 \
+                else hi == exact >> (exact.bit_length() - 64)
+        else:
+            p = 5 ** (-q)
+            assert hi == (1 << (63 + p.bit_length())) // p
+        out.append(hi)
+    return out
+
+
 def emit(header_path: str) -> None:
     table = gen()
+    bases, fix_words = gen_compact(table)
+    float_table = gen_float(table)
     now = datetime.datetime.utcnow().strftime("%Y-%m-%d")
 
     with open(header_path, "w", encoding="utf-8", newline="\n") as f:
         f.write("#pragma once\n\n")
         f.write("// Generated by chfloat/script/gen_pow5_table.py on {} UTC\n".format(now))
-        f.write("// Cached 128-bit representations of 5^q for q in [-342, 308].\n")
-        f.write("// Table layout: entry i corresponds to q = smallest_q + i.\n\n")
-        f.write("#include <cstdint>\n\n")
+        f.write("// Cached 128-bit representations of 5^q for q in [{}, {}].\n".format(SMALLEST_Q, LARGEST_Q))
+        f.write("// Table layout: entry i corresponds to q = smallest_q + i.\n")
+        f.write("// CHFLOAT_COMPACT_POW5 selects the compact form; read entries through pow5_entry().\n\n\n")
         f.write("namespace chfloat {\nnamespace detail {\n\n")
-        f.write("struct alignas(16) pow5_128 { std::uint64_t hi; std::uint64_t lo; };\n\n")
+        f.write("struct alignas(16) pow5_128 { unsigned long long hi; unsigned long long lo; };\n\n")
         f.write("inline constexpr int pow5_smallest_q = {};\n".format(SMALLEST_Q))
         f.write("inline constexpr int pow5_largest_q = {};\n".format(LARGEST_Q))
-        f.write("alignas(64) inline constexpr pow5_128 pow5_table[] = {\n")
 
+        f.write("\n// binary32 only: 64-bit truncated 5^q, normalized to [2^63, 2^64).\n")
+        f.write("inline constexpr int pow5_float_smallest_q = {};\n".format(FLOAT_SMALLEST_Q))
+        f.write("inline constexpr int pow5_float_largest_q = {};\n".format(FLOAT_LARGEST_Q))
+        f.write("alignas(64) inline constexpr unsigned long long pow5_float_table[] = {\n")
+        for hi in float_table:
+            f.write("  0x%016xULL,\n" % hi)
+        f.write("};\n")
+
+        f.write("\n#if defined(CHFLOAT_COMPACT_POW5)\n\n")
+        f.write("// Entry i = top 128 bits of pow5_compact_base[i / step] * pow5_small[i % step]\n")
+        f.write("//           + ((pow5_compact_fix[i / 32] >> (2 * (i % 32))) & 3).\n")
+        f.write("inline constexpr int pow5_compact_step = {};\n".format(COMPACT_STEP))
+        f.write("alignas(64) inline constexpr pow5_128 pow5_compact_base[] = {\n")
+        for (hi, lo) in bases:
+            f.write("  { 0x%016xULL, 0x%016xULL },\n" % (hi, lo))
+        f.write("};\n")
+        f.write("alignas(64) inline constexpr unsigned long long pow5_small[] = {\n")
+        for r in range(COMPACT_STEP):
+            f.write("  0x%016xULL,\n" % (5 ** r))
+        f.write("};\n")
+        f.write("inline constexpr unsigned long long pow5_compact_fix[] = {\n")
+        for w in fix_words:
+            f.write("  0x%016xULL,\n" % w)
+        f.write("};\n")
+        f.write("inline constexpr decltype(sizeof(0)) pow5_table_bytes =\n")
+        f.write("    sizeof(pow5_compact_base) + sizeof(pow5_small) + sizeof(pow5_compact_fix);\n")
+
+        f.write("\n#else\n\n")
+        f.write("alignas(64) inline constexpr pow5_128 pow5_table[] = {\n")
         for (hi, lo) in table:
             f.write("  { 0x%016xULL, 0x%016xULL },\n" % (hi, lo))
-
-        f.write("};\n\n")
+        f.write("};\n")
+        f.write("inline constexpr decltype(sizeof(0)) pow5_table_bytes = sizeof(pow5_table);\n")
+        f.write("\n#endif\n\n")
         f.write("} // namespace detail\n} // namespace chfloat\n")
 
 
 if __name__ == "__main__":
-    emit("c:/CC/src/cf/chfloat/include/chfloat/detail/pow5_table.h")
+    here = os.path.dirname(os.path.abspath(__file__))
+    emit(os.path.join(here, "..", "include", "chfloat", "detail", "pow5_table.h"))
@@ -0,0 +1,279 @@
+// Differential correctness harness: chfloat::from_chars against the C library's strtod/strtof,
+// bit for bit, over generated inputs.
+//
+//   chfloat_differential [--count N] [--seed S] [--threads T] [--exhaustive-float]
+//
+// Every generator below produces `count` inputs (split across threads):
+//   - random_double / random_float: random finite bit patterns printed with %.<p>g,
+//     p in [1, 17] / [1, 9], parsed as double and as float
+//   - halfway_float / halfway_double: exact decimal expansions of the midpoint between two
+//     adjacent values, plus the same text nudged just above and just below it
+//   - subnormal: random subnormal bit patterns and values around the underflow thresholds
+//   - long_mantissa: %.17g output with extra random digits, and 20-100 digit random decimals
+// --exhaustive-float additionally formats all 2^32 float bit patterns with chfloat::to_chars
+// and checks that from_chars round-trips them and agrees with strtof.
+//
+// The exit code is non-zero if any input disagrees; the first mismatches are printed.
+
+#include <chfloat/chfloat.h>
+
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<unsigned long long> g_checked{0};
+std::atomic<unsigned long long> g_mismatches{0};
+std::mutex g_report_mutex;
+
+template <class T>
+static uint64_t bits_of(T v) {
+  uint64_t out = 0;
+  std::memcpy(&out, &v, sizeof(T));
+  return out;
+}
+
+static double double_from_bits(uint64_t b) {
+  double d;
+  std::memcpy(&d, &b, sizeof(d));
+  return d;
+}
+
+static float float_from_bits(uint32_t b) {
+  float f;
+  std::memcpy(&f, &b, sizeof(f));
+  return f;
+}
+
+static void report(const char* kind, const std::string& s, uint64_t got, uint64_t want, bool ptr_ok) {
+  if (g_mismatches.fetch_add(1) >= 20) return;
+  std::lock_guard<std::mutex> lock(g_report_mutex);
+  std::fprintf(stderr, "MISMATCH %s: \"%s\" chfloat=0x%016llx libc=0x%016llx%s\n", kind, s.c_str(),
+               static_cast<unsigned long long>(got), static_cast<unsigned long long>(want),
+               ptr_ok ? "" : " (end pointer differs)");
+}
+
+// Parses s with both libraries as double and as float and compares values and end pointers.
+// Out-of-range results are compared by value only (the libraries differ in when they flag them).
+static void check(const std::string& s) {
+  const char* first = s.c_str();
+  const char* last = first + s.size();
+  {
+    double got = 0;
+    const chfloat::from_chars_result r = chfloat::from_chars(first, last, got);
+    char* end = nullptr;
+    const double want = std::strtod(first, &end);
+    const bool ptr_ok = (r.ptr == end);
+    if (bits_of(got) != bits_of(want) || !ptr_ok) report("double", s, bits_of(got), bits_of(want), ptr_ok);
+  }
+  {
+    float got = 0;
+    const chfloat::from_chars_result r = chfloat::from_chars(first, last, got);
+    char* end = nullptr;
+    const float want = std::strtof(first, &end);
+    const bool ptr_ok = (r.ptr == end);
+    if (bits_of(got) != bits_of(want) || !ptr_ok) report("float", s, bits_of(got), bits_of(want), ptr_ok);
+  }
+  g_checked.fetch_add(1, std::memory_order_relaxed);
+}
+
+static std::string printf_string(const char* fmt, int precision, double v) {
+  char buf[2048];
+  const int len = std::snprintf(buf, sizeof(buf), fmt, precision, v);
+  return std::string(buf, static_cast<size_t>(len));
+}
+
+static double random_finite_double(std::mt19937_64& rng) {
+  for (;;) {
+    const double d = double_from_bits(rng());
+    if (std::isfinite(d)) return d;
+  }
+}
+
+static float random_finite_float(std::mt19937_64& rng) {
+  for (;;) {
+    const float f = float_from_bits(static_cast<uint32_t>(rng()));
+    if (std::isfinite(f)) return f;
+  }
+}
+
+// Checks an exact decimal expansion ("d.ddd...e+XX") and the same text nudged just above (an
+// extra trailing 1) and just below (truncated before its last non-zero digit).
+static void check_nudged(const std::string& exact) {
+  check(exact);
+  const size_t e = exact.find('e');
+  const std::string mant = exact.substr(0, e);
+  const std::string exp = exact.substr(e);
+  check(mant + "1" + exp);
+  const size_t nz = mant.find_last_not_of("0.");
+  if (nz != std::string::npos && nz > 1) check(mant.substr(0, nz) + exp);
+}
+
+static void gen_random_double(std::mt19937_64& rng) {
+  const double d = random_finite_double(rng);
+  check(printf_string("%.*g", 17, d));
+  check(printf_string("%.*g", 1 + static_cast<int>(rng() % 17), d));
+}
+
+static void gen_random_float(std::mt19937_64& rng) {
+  const float f = random_finite_float(rng);
+  check(printf_string("%.*g", 9, static_cast<double>(f)));
+  check(printf_string("%.*g", 1 + static_cast<int>(rng() % 9), static_cast<double>(f)));
+}
+
+static void gen_halfway_float(std::mt19937_64& rng) {
+  // The midpoint of two adjacent floats has 25 significant bits, so it is exact as a double and
+  // %.200e prints its full expansion.
+  const float f = std::fabs(random_finite_float(rng));
+  const float next = std::nextafter(f, std::numeric_limits<float>::infinity());
+  if (!std::isfinite(next)) return;
+  const double mid = (static_cast<double>(f) + static_cast<double>(next)) / 2;
+  check_nudged(printf_string("%.*e", 200, mid));
+}
+
+static void gen_halfway_double(std::mt19937_64& rng) {
+#if LDBL_MANT_DIG >= 64
+  // 54 significant bits: exact in an x87 extended long double.
+  const double d = std::fabs(random_finite_double(rng));
+  const double next = std::nextafter(d, std::numeric_limits<double>::infinity());
+  if (!std::isfinite(next)) return;
+  const long double mid = (static_cast<long double>(d) + static_cast<long double>(next)) / 2;
+  char buf[1200];
+  const int len = std::snprintf(buf, sizeof(buf), "%.*Le", 1100, mid);
+  if (len <= 0 || static_cast<size_t>(len) >= sizeof(buf)) return;
+  check_nudged(std::string(buf, static_cast<size_t>(len)));
+#else
+  (void)rng;
+#endif
+}
+
+static void gen_subnormal(std::mt19937_64& rng) {
+  const double d = double_from_bits(rng() & 0x800fffffffffffffULL);
+  check(printf_string("%.*g", 17, d));
+  check(printf_string("%.*g", 1 + static_cast<int>(rng() % 17), d));
+  const float f = float_from_bits(static_cast<uint32_t>(rng()) & 0x807fffffu);
+  check(printf_string("%.*g", 9, static_cast<double>(f)));
+  // Around the underflow thresholds: 2^-1075 (half the smallest double) and 2^-150.
+  const double scale = 1.0 + static_cast<double>(rng() % 2000) / 1000.0 - 0.5;
+  check(printf_string("%.*g", 1 + static_cast<int>(rng() % 25), scale * std::ldexp(1.0, -1075)));
+  check(printf_string("%.*g", 1 + static_cast<int>(rng() % 25), scale * std::ldexp(1.0, -150)));
+}
+
+static void gen_long_mantissa(std::mt19937_64& rng) {
+  std::string s = printf_string("%.*e", 16, random_finite_double(rng));
+  const size_t e = s.find('e');
+  std::string extra;
+  for (int n = 1 + static_cast<int>(rng() % 30); n > 0; --n) extra += static_cast<char>('0' + rng() % 10);
+  check(s.substr(0, e) + extra + s.substr(e));
+
+  std::string t;
+  if (rng() & 1) t += '-';
+  const int digits = 20 + static_cast<int>(rng() % 81);
+  const int dot = static_cast<int>(rng() % static_cast<uint64_t>(digits + 1));
+  for (int i = 0; i < digits; ++i) {
+    if (i == dot) t += '.';
+    t += static_cast<char>('0' + rng() % 10);
+  }
+  t += 'e' + std::to_string(static_cast<int>(rng() % 700) - 350);
+  check(t);
+}
+
+static void run_threads(unsigned threads, unsigned long long count, uint64_t seed, void (*gen)(std::mt19937_64&)) {
+  std::vector<std::thread> pool;
+  for (unsigned t = 0; t < threads; ++t) {
+    pool.emplace_back([=] {
+      std::mt19937_64 rng(seed ^ (0x9e3779b97f4a7c15ULL * (t + 1)));
+      const unsigned long long begin = count * t / threads;
+      const unsigned long long end = count * (t + 1) / threads;
+      for (unsigned long long i = begin; i < end; ++i) gen(rng);
+    });
+  }
+  for (auto& th : pool) th.join();
+}
+
+static void run_exhaustive_float(unsigned threads) {
+  std::vector<std::thread> pool;
+  for (unsigned t = 0; t < threads; ++t) {
+    pool.emplace_back([=] {
+      const uint64_t begin = (1ULL << 32) * t / threads;
+      const uint64_t end = (1ULL << 32) * (t + 1) / threads;
+      unsigned long long checked = 0;
+      for (uint64_t b = begin; b < end; ++b) {
+        const float f = float_from_bits(static_cast<uint32_t>(b));
+        if (!std::isfinite(f)) continue;
+        char buf[32];
+        const chfloat::to_chars_result tr = chfloat::to_chars(buf, buf + sizeof(buf) - 1, f);
+        *tr.ptr = '\0';
+        float got = 0;
+        const chfloat::from_chars_result r = chfloat::from_chars(buf, tr.ptr, got);
+        const float want = std::strtof(buf, nullptr);
+        if (bits_of(got) != b || bits_of(want) != b || r.ptr != tr.ptr) {
+          report("exhaustive float", buf, bits_of(got), b, r.ptr == tr.ptr);
+        }
+        ++checked;
+      }
+      g_checked.fetch_add(checked);
+    });
+  }
+  for (auto& th : pool) th.join();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  unsigned long long count = 1000000;
+  uint64_t seed = 12345;
+  unsigned threads = std::thread::hardware_concurrency();
+  bool exhaustive_float = false;
+
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+      count = std::strtoull(argv[++i], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--exhaustive-float") == 0) {
+      exhaustive_float = true;
+    } else {
+      std::fprintf(stderr, "usage: %s [--count N] [--seed S] [--threads T] [--exhaustive-float]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (threads == 0) threads = 1;
+
+  struct generator {
+    const char* name;
+    void (*gen)(std::mt19937_64&);
+  };
+  const generator generators[] = {
+      {"random_double", gen_random_double}, {"random_float", gen_random_float},
+      {"halfway_float", gen_halfway_float}, {"halfway_double", gen_halfway_double},
+      {"subnormal", gen_subnormal},         {"long_mantissa", gen_long_mantissa},
+  };
+  for (const generator& g : generators) {
+    const unsigned long long before = g_checked.load();
+    run_threads(threads, count, seed, g.gen);
+    std::printf("%-15s %llu inputs\n", g.name, g_checked.load() - before);
+  }
+  if (exhaustive_float) {
+    const unsigned long long before = g_checked.load();
+    run_exhaustive_float(threads);
+    std::printf("%-15s %llu inputs\n", "exhaustive", g_checked.load() - before);
+  }
+
+  const unsigned long long bad = g_mismatches.load();
+  std::printf("checked %llu inputs, %llu mismatches\n", g_checked.load(), bad);
+  return bad == 0 ? 0 : 1;
+}
@@ -1,4 +1,7 @@
 #include <chfloat/chfloat.h>
+#include <chfloat/csv.h>
+#include <chfloat/parallel.h>
+#include <chfloat/stream.h>
 
 #include <cmath>
 #include <cstdint>
@@ -110,6 +113,358 @@ static void test_float_double_basic() {
   test_parse_ok<double>("1e-308", 1e-308);
 }
 
+static void test_float_long_digit_runs() {
+  // Digits past the 19/10-digit budget: dropped fraction digits must not rescale the value,
+  // and leading zeros are not significant.
+  test_parse_ok<double>("1.23456789012345678901", 1.23456789012345678901);
+  test_parse_ok<float>("1.2345678901234", 1.2345678901234f);
+  test_parse_ok<double>("00000000000000000000001", 1.0);
+  test_parse_ok<double>("0.00000000000000000000001", 1e-23);
+  test_parse_ok<float>("0.00000000000000000000001", 1e-23f);
+  test_parse_ok<double>("123456789012345678901", 123456789012345678901.0);
+
+  // 8-digit chunk boundaries, with leading zeros inside a chunk.
+  test_parse_ok<double>("12345678", 12345678.0);
+  test_parse_ok<double>("1234567890123456", 1234567890123456.0);
+  test_parse_ok<double>("0.000000001234567", 0.000000001234567);
+  test_parse_ok<double>("00000000123456789.5", 123456789.5);
+  test_parse_ok<float>("0000000012345678", 12345678.0f);
+
+  // Same tokens inside a longer buffer, where whole 16-byte blocks are classified at once.
+  const std::string_view s = "3.14159265358979323846264338327950288,12345678901234567890123e-3,0.5,7.";
+  const double expected[] = {3.14159265358979323846264338327950288, 12345678901234567890.123, 0.5, 7.0};
+  const char* p = s.data();
+  for (double e : expected) {
+    double out = 0;
+    auto r = chfloat::from_chars(p, s.data() + s.size(), out);
+    CHECK(r.ec == chfloat::errc::ok);
+    CHECK(out == e);
+    p = r.ptr + 1;
+  }
+  CHECK(p == s.data() + s.size() + 1);
+}
+
+static void test_float_correct_rounding() {
+  // Halfway cases where the digits past the 19th (double) / 10th (float) decide the rounding.
+  test_parse_ok<double>("9007199254740993", 9007199254740992.0);
+  test_parse_ok<double>("9007199254740993.00000000000000000000000000000", 9007199254740992.0);
+  test_parse_ok<double>("9007199254740993.00000000000000000000000000001", 9007199254740994.0);
+  test_parse_ok<double>("9007199254740992.99999999999999999999999999999", 9007199254740992.0);
+  test_parse_ok<float>("1.000000059604644775390625", 1.0f);
+  test_parse_ok<float>("1.0000000596046447753906250000000001", std::nextafter(1.0f, 2.0f));
+  test_parse_ok<float>("1.0000000596046447753906249999999999", 1.0f);
+  // Exact 10-digit mantissas whose binary64 product with 10^e rounds twice on the way to float.
+  test_parse_ok<float>("9644154697e10", 0x1.4e994ep+66f);
+  test_parse_ok<float>("9668234958e-36", 0x1.7eff8ep-87f);
+  test_parse_ok<float>("3773287409e15", 0x1.8f832ap+81f);
+  test_parse_ok<float>("3023785331e16", 0x1.9031d6p+84f);
+  const std::string_view min_half_f =
+      "7.00649232162408535461864791644958065640130970938257885878534141944895541342930300743319094181060791015625e-46";
+  {
+    // Exactly half of the smallest subnormal rounds to even, i.e. to zero: out of range.
+    float f = 1.0f;
+    auto r = chfloat::from_chars(min_half_f.data(), min_half_f.data() + min_half_f.size(), f);
+    CHECK(r.ec == chfloat::errc::result_out_of_range && f == 0.0f);
+  }
+  test_parse_ok<float>(std::string(min_half_f).insert(min_half_f.size() - 4, "1"),
+                       std::numeric_limits<float>::denorm_min());
+
+  // Just below the midpoint between DBL_MAX and 2^1024.
+  std::string below_inf =
+      "17976931348623158079372897140530341507993413271003782693617377898044496829276475094664901797758720709633"
+      "02864166928879109465555478519404026306574886715058206819089020007083836762738548458177115317644757302700"
+      "69855571366959622842914819860834936475292719074168444365510704342711559699508093042880177904174497792";
+  below_inf.back() = '1';
+  test_parse_ok<double>(below_inf, std::numeric_limits<double>::max());
+
+  // Long inputs: many digits that cancel against the exponent.
+  test_parse_ok<double>("1" + std::string(1000, '0') + "e-1000", 1.0);
+  test_parse_ok<double>("0." + std::string(10000, '0') + "1e10001", 1.0);
+  test_parse_ok<float>("0." + std::string(10000, '0') + "15e10001", 1.5f);
+}
+
+static void test_float_hex() {
+  const auto hex = chfloat::chars_format::hex;
+  test_parse_ok<double>("1p0", 1.0, hex);
+  test_parse_ok<double>("0x1.8p1", 3.0, hex);
+  test_parse_ok<double>("-0X1.8P+1", -3.0, hex);
+  test_parse_ok<double>("a.8", 10.5, hex);
+  test_parse_ok<double>("1.fffffffffffffp1023", std::numeric_limits<double>::max(), hex);
+  test_parse_ok<double>("0x1p-1074", std::numeric_limits<double>::denorm_min(), hex);
+  test_parse_ok<double>("0x0.0000000000001p-1022", std::numeric_limits<double>::denorm_min(), hex);
+  test_parse_ok<double>("0x.8p-1073", std::numeric_limits<double>::denorm_min(), hex);
+  test_parse_ok<float>("1.fffffep127", std::numeric_limits<float>::max(), hex);
+  test_parse_ok<float>("0x1p-149", std::numeric_limits<float>::denorm_min(), hex);
+  test_parse_ok<float>("inf", std::numeric_limits<float>::infinity(), hex);
+
+  // Rounding happens once, at the final shift: ties to even, anything beyond the tie rounds up.
+  test_parse_ok<double>("1.00000000000008", 1.0, hex);
+  test_parse_ok<double>("1.00000000000018", 1.0 + 2 * std::numeric_limits<double>::epsilon(), hex);
+  test_parse_ok<double>("1.000000000000080000000000000001", 1.0 + std::numeric_limits<double>::epsilon(), hex);
+  test_parse_ok<double>("0x1.8p-1074", 2 * std::numeric_limits<double>::denorm_min(), hex);
+  test_parse_ok<float>("1.000001", 1.0f, hex);
+
+  {
+    double v = 0;
+    const std::string_view over = "1p1024";
+    auto r = chfloat::from_chars(over.data(), over.data() + over.size(), v, hex);
+    CHECK(r.ec == chfloat::errc::result_out_of_range && is_inf(v));
+    const std::string_view under = "1p-1075";
+    r = chfloat::from_chars(under.data(), under.data() + under.size(), v, hex);
+    CHECK(r.ec == chfloat::errc::result_out_of_range && v == 0.0);
+    // "0x" without hex digits is the number 0 followed by 'x'.
+    const std::string_view prefix_only = "0x";
+    r = chfloat::from_chars(prefix_only.data(), prefix_only.data() + 2, v, hex);
+    CHECK(r.ec == chfloat::errc::ok && r.ptr == prefix_only.data() + 1 && v == 0.0);
+    const std::string_view bad = "p3";
+    r = chfloat::from_chars(bad.data(), bad.data() + 2, v, hex);
+    CHECK(r.ec == chfloat::errc::invalid_argument && r.ptr == bad.data());
+  }
+}
+
+static void test_pow5_entry() {
+  // 5^q for q in [0, 55] fits in 128 bits, so the normalized entries are exact.
+  uint64_t hi = 0, lo = 1;
+  for (int q = 0; q <= 55; ++q) {
+    uint64_t nhi = hi, nlo = lo;
+    while ((nhi >> 63) == 0) {
+      nhi = (nhi << 1) | (nlo >> 63);
+      nlo <<= 1;
+    }
+    const chfloat::detail::pow5_128 e = chfloat::detail::pow5_entry(q);
+    CHECK(e.hi == nhi && e.lo == nlo);
+    const uint64_t lo4 = lo << 2;
+    const uint64_t sum = lo4 + lo;
+    hi = (hi << 2) + (lo >> 62) + hi + (sum < lo ? 1u : 0u);
+    lo = sum;
+  }
+  // Entries on both sides of a compact base, and the ends of the range.
+  CHECK(chfloat::detail::pow5_entry(-342).hi == 0xeef453d6923bd65aULL);
+  CHECK(chfloat::detail::pow5_entry(-1).hi == 0xccccccccccccccccULL);
+  CHECK(chfloat::detail::pow5_entry(-1).lo == 0xcccccccccccccccdULL);
+  CHECK(chfloat::detail::pow5_entry(308).hi == 0x8e679c2f5e44ff8fULL);
+  // The binary32 table holds the high words of the same entries.
+  for (int q = chfloat::detail::pow5_float_smallest_q; q <= chfloat::detail::pow5_float_largest_q; ++q) {
+    CHECK(chfloat::detail::pow5_float_table[q - chfloat::detail::pow5_float_smallest_q] ==
+          chfloat::detail::pow5_entry(q).hi);
+  }
+}
+
+static void test_float_formats() {
+  const auto fixed = chfloat::chars_format::fixed;
+  const auto sci = chfloat::chars_format::scientific;
+  test_parse_ok<double>("1.25", 1.25, fixed);
+  test_parse_ok<double>("-0.1", -0.1, fixed);
+  test_parse_ok<double>("1.5e3", 1500.0, sci);
+  test_parse_ok<double>("-2E-2", -0.02, sci);
+  test_parse_ok<float>("3.75", 3.75f, fixed);
+  test_parse_ok<float>("3.75e+1", 37.5f, sci);
+  test_parse_ok<double>("inf", std::numeric_limits<double>::infinity(), sci);
+  test_parse_ok<double>("1" + std::string(400, '0') + "e-400", 1.0, sci);
+
+  {
+    // fixed: the exponent is not part of the number.
+    double v = 0;
+    const std::string_view s = "1.5e3";
+    auto r = chfloat::from_chars(s.data(), s.data() + s.size(), v, fixed);
+    CHECK(r.ec == chfloat::errc::ok && r.ptr == s.data() + 3 && v == 1.5);
+    float f = 0;
+    auto rf = chfloat::from_chars(s.data(), s.data() + s.size(), f, fixed);
+    CHECK(rf.ec == chfloat::errc::ok && rf.ptr == s.data() + 3 && f == 1.5f);
+  }
+  {
+    // scientific: the exponent is required.
+    double v = 0;
+    for (std::string_view s : {"1.5", "1.5e", "1.5e+", "7"}) {
+      auto r = chfloat::from_chars(s.data(), s.data() + s.size(), v, sci);
+      CHECK(r.ec == chfloat::errc::invalid_argument && r.ptr == s.data());
+      float f = 0;
+      auto rf = chfloat::from_chars(s.data(), s.data() + s.size(), f, sci);
+      CHECK(rf.ec == chfloat::errc::invalid_argument && rf.ptr == s.data());
+    }
+  }
+}
+
+static void test_from_chars_scaled() {
+  auto scaled = [](std::string_view s, int scale, long long expected, bool exact) {
+    long long v = -1;
+    auto r = chfloat::from_chars_scaled(s.data(), s.data() + s.size(), v, scale);
+    CHECK(r.ec == chfloat::errc::ok && r.ptr == s.data() + s.size());
+    CHECK(v == expected && r.exact == exact);
+  };
+  scaled("12.3456", 4, 123456, true);
+  scaled("-12.3456", 4, -123456, true);
+  scaled("12.3", 4, 123000, true);
+  scaled("1.5e-2", 4, 150, true);
+  scaled("7", -1, 1, false);
+  scaled("0.00005", 4, 0, false);   // tie, to even
+  scaled("0.00015", 4, 2, false);   // tie, to even
+  scaled("0.000050000000000000000000001", 4, 1, false);
+  scaled("0.123456789012345678950001", 19, 1234567890123456790LL, false);
+  scaled("0.1", 0, 0, false);
+  scaled("0e999999", 4, 0, true);
+  scaled("9223372036854775807", 0, 9223372036854775807LL, true);
+  scaled("-9223372036854775808", 0, -9223372036854775807LL - 1, true);
+  scaled("922337203685477580.7", 1, 9223372036854775807LL, true);
+  scaled("9223372036854775806.5", 0, 9223372036854775806LL, false);
+  scaled("9223372036854775806.50001", 0, 9223372036854775807LL, false);
+
+  {
+    long long v = 42;
+    for (std::string_view s : {"9223372036854775808", "9223372036854775807.5", "1e19", "1e400"}) {
+      auto r = chfloat::from_chars_scaled(s.data(), s.data() + s.size(), v, 0);
+      CHECK(r.ec == chfloat::errc::result_out_of_range && r.ptr == s.data() + s.size() && v == 42);
+    }
+  }
+  {
+    long long v = 42;
+    const std::string_view inf = "inf";
+    auto r = chfloat::from_chars_scaled(inf.data(), inf.data() + inf.size(), v, 2);
+    CHECK(r.ec == chfloat::errc::invalid_argument && r.ptr == inf.data() && v == 42);
+  }
+}
+
+static void test_decimal_decomposition() {
+  {
+    chfloat::decimal d{};
+    const std::string_view s = "-123.45e2x";
+    auto r = chfloat::parse_decimal(s.data(), s.data() + s.size(), d);
+    CHECK(r.ec == chfloat::errc::ok && r.ptr == s.data() + 9);
+    CHECK(d.mantissa == 12345 && d.exponent == 0 && d.negative && d.exact);
+    double v = 0;
+    CHECK(chfloat::to_double(d, v) == chfloat::errc::ok && v == -12345.0);
+    float f = 0;
+    CHECK(chfloat::to_float(d, f) == chfloat::errc::ok && f == -12345.0f);
+  }
+  {
+    // Truncated mantissa: the conversions re-read the source digits.
+    const std::string_view s = "2.22507385850720113605740979670913197593481954635164564802342610972482222202107694551652952390813508"
+                               "7914149158913039621106870086438694594645527657207407820621743379988141063267329253552286881372149012"
+                               "9811224514518898490572223072852551331557550159143974763979834118019993239625482890171070818506906306"
+                               "6665599493827577257201576306269066333264756530000924588831643303777979186961204949739037782970490505"
+                               "1080609940730262937128958950003583799967207254304360284078895771796150945516748243471030702609144621"
+                               "5722898802581825451803257070188608721131280795122334262883686223215037756666225039825343359745688844"
+                               "2390026549819838548794829220689472168983109969836584681402285424333066033985088644580400103493397042"
+                               "7567186443383770486037861622771738545623065874679014086723327636718751234567890123456789012345678901"
+                               "e-308";
+    chfloat::decimal d{};
+    CHECK(chfloat::parse_decimal(s.data(), s.data() + s.size(), d).ec == chfloat::errc::ok);
+    CHECK(!d.exact && d.mantissa == 2225073858507201136ULL && d.exponent == -326);
+    double v = 0, expected = 0;
+    CHECK(chfloat::to_double(d, v) == chfloat::errc::ok);
+    chfloat::from_chars(s.data(), s.data() + s.size(), expected);
+    CHECK(v == expected);
+  }
+  {
+    // A hand-built decimal: ties of binary32 and binary64 need the exact mantissa.
+    const chfloat::decimal half_up{9007199254740993ULL, 0, false, true, nullptr, nullptr};
+    double v = 0;
+    CHECK(chfloat::to_double(half_up, v) == chfloat::errc::ok && v == 9007199254740992.0);
+    const chfloat::decimal f_tie{16777217ULL, 0, true, true, nullptr, nullptr};
+    float f = 0;
+    CHECK(chfloat::to_float(f_tie, f) == chfloat::errc::ok && f == -16777216.0f);
+    const chfloat::decimal f_wide{3402823567797336617ULL, 20, false, true, nullptr, nullptr};
+    CHECK(chfloat::to_float(f_wide, f) == chfloat::errc::result_out_of_range && is_inf(f));
+    const chfloat::decimal f_max{3402823567797336616ULL, 20, false, true, nullptr, nullptr};
+    CHECK(chfloat::to_float(f_max, f) == chfloat::errc::ok && f == std::numeric_limits<float>::max());
+  }
+  {
+    chfloat::decimal d{};
+    const std::string_view nan = "nan";
+    CHECK(chfloat::parse_decimal(nan.data(), nan.data() + nan.size(), d).ec == chfloat::errc::invalid_argument);
+  }
+  {
+    // Overflow is reported whether it is caught by the exponent range or by rounding.
+    for (std::string_view s : {"1e39", "3.5e38", "340282356779733661637539395458142568448"}) {
+      float f = 0;
+      auto r = chfloat::from_chars(s.data(), s.data() + s.size(), f);
+      CHECK(r.ec == chfloat::errc::result_out_of_range && r.ptr == s.data() + s.size() && is_inf(f));
+    }
+    for (std::string_view s : {"1e309", "1.7976931348623159e308"}) {
+      double v = 0;
+      auto r = chfloat::from_chars(s.data(), s.data() + s.size(), v);
+      CHECK(r.ec == chfloat::errc::result_out_of_range && r.ptr == s.data() + s.size() && is_inf(v));
+    }
+    double v = 0;
+    const std::string_view tiny = "2e-324";
+    CHECK(chfloat::from_chars(tiny.data(), tiny.data() + tiny.size(), v).ec == chfloat::errc::result_out_of_range);
+  }
+}
+
+template <class T>
+static std::string to_chars_string(T v) {
+  char buf[32];
+  auto r = chfloat::to_chars(buf, buf + sizeof(buf), v);
+  CHECK(r.ec == chfloat::errc::ok);
+  return std::string(buf, r.ptr);
+}
+
+static void test_to_chars_shortest() {
+  CHECK(to_chars_string(0.0) == "0");
+  CHECK(to_chars_string(-0.0) == "-0");
+  CHECK(to_chars_string(1.0) == "1");
+  CHECK(to_chars_string(0.1) == "0.1");
+  CHECK(to_chars_string(-1.5) == "-1.5");
+  CHECK(to_chars_string(123456.0) == "123456");
+  CHECK(to_chars_string(0.001) == "0.001");
+  CHECK(to_chars_string(0.0001) == "1e-04"); // shorter than "0.0001"
+  CHECK(to_chars_string(1e5) == "1e+05");
+  CHECK(to_chars_string(1e22) == "1e+22");
+  CHECK(to_chars_string(1.5e-7) == "1.5e-07");
+  CHECK(to_chars_string(0.1 + 0.2) == "0.30000000000000004");
+  CHECK(to_chars_string(9007199254740993.0) == "9007199254740992");
+  CHECK(to_chars_string(123456789012345680000.0) == "123456789012345683968"); // plain: exact digits
+  CHECK(to_chars_string(std::numeric_limits<double>::max()) == "1.7976931348623157e+308");
+  CHECK(to_chars_string(std::numeric_limits<double>::min()) == "2.2250738585072014e-308");
+  CHECK(to_chars_string(std::numeric_limits<double>::denorm_min()) == "5e-324");
+  CHECK(to_chars_string(std::numeric_limits<double>::infinity()) == "inf");
+  CHECK(to_chars_string(-std::numeric_limits<double>::infinity()) == "-inf");
+  CHECK(to_chars_string(make_nan<double>()) == "nan");
+  CHECK(to_chars_string(0.3f) == "0.3");
+  CHECK(to_chars_string(16777216.0f) == "16777216");
+  CHECK(to_chars_string(3e10f) == "3e+10");
+  CHECK(to_chars_string(std::numeric_limits<float>::max()) == "3.4028235e+38");
+  CHECK(to_chars_string(std::numeric_limits<float>::denorm_min()) == "1e-45");
+
+  {
+    // Too small: value_too_large, ptr == last.
+    char buf[24];
+    auto r = chfloat::to_chars(buf, buf + 4, 1.25);
+    CHECK(r.ec == chfloat::errc::ok && r.ptr == buf + 4);
+    r = chfloat::to_chars(buf, buf + 3, 1.25);
+    CHECK(r.ec == chfloat::errc::value_too_large && r.ptr == buf + 3);
+    r = chfloat::to_chars(buf, buf + 2, -std::numeric_limits<double>::infinity());
+    CHECK(r.ec == chfloat::errc::value_too_large && r.ptr == buf + 2);
+    r = chfloat::to_chars(buf, buf + sizeof(buf), -std::numeric_limits<double>::min());
+    CHECK(r.ec == chfloat::errc::ok && r.ptr - buf == 24);
+  }
+
+  // Round trip through from_chars.
+  uint64_t x = 0x9e3779b97f4a7c15ULL;
+  for (int i = 0; i < 20000; ++i) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    double d = 0;
+    std::memcpy(&d, &x, sizeof(d));
+    float f = 0;
+    const uint32_t xf = static_cast<uint32_t>(x >> 16);
+    std::memcpy(&f, &xf, sizeof(f));
+    if (std::isfinite(d)) {
+      const std::string s = to_chars_string(d);
+      double back = 0;
+      chfloat::from_chars(s.data(), s.data() + s.size(), back);
+      CHECK(bitcast_u64(back) == bitcast_u64(d));
+    }
+    if (std::isfinite(f)) {
+      const std::string s = to_chars_string(f);
+      float back = 0;
+      chfloat::from_chars(s.data(), s.data() + s.size(), back);
+      CHECK(std::memcmp(&back, &f, sizeof(f)) == 0);
+    }
+  }
+}
+
 static void test_float_specials_if_supported() {
   // std::from_chars floating parsing support varies across standard libraries.
   // We only assert that these don't crash; result may be invalid_argument.
@@ -132,6 +487,308 @@ static void test_float_errors() {
   test_parse_err<double>("1e9999"); // out of range
 }
 
+static void test_from_chars_json() {
+  struct jcase {
+    const char* s;
+    size_t end; // 0: invalid_argument
+    bool integer;
+    double value;
+  };
+  const jcase cases[] = {
+      {"0", 1, true, 0.0},
+      {"-0", 2, true, -0.0},
+      {"123,", 3, true, 123.0},
+      {"-12.5]", 5, false, -12.5},
+      {"1e3", 3, false, 1000.0},
+      {"0.5E-1}", 6, false, 0.05},
+      {"2E+2", 4, false, 200.0},
+      {"12345678901234567890", 20, true, 12345678901234567890.0},
+      {"1.5.3", 3, false, 1.5}, // the second '.' is the tokenizer's problem
+      {"+1", 0, false, 0.0},
+      {"01", 0, false, 0.0},
+      {"-01.5", 0, false, 0.0},
+      {".5", 0, false, 0.0},
+      {"1.", 0, false, 0.0},
+      {"1.e5", 0, false, 0.0},
+      {"1e", 0, false, 0.0},
+      {"1e+", 0, false, 0.0},
+      {"-", 0, false, 0.0},
+      {"inf", 0, false, 0.0},
+      {"NaN", 0, false, 0.0},
+      {"", 0, false, 0.0},
+  };
+  for (const jcase& c : cases) {
+    const std::string_view s = c.s;
+    double v = 42.0;
+    const auto r = chfloat::from_chars_json(s.data(), s.data() + s.size(), v);
+    const auto rv = chfloat::validate(s.data(), s.data() + s.size(), chfloat::chars_format::json);
+    if (c.end == 0) {
+      CHECK(r.ec == chfloat::errc::invalid_argument && r.ptr == s.data() && v == 42.0);
+      CHECK(rv.ec == chfloat::errc::invalid_argument);
+    } else {
+      CHECK(r.ec == chfloat::errc::ok && r.ptr == s.data() + c.end && r.integer == c.integer);
+      CHECK(bitcast_u64(v) == bitcast_u64(c.value));
+      CHECK(rv.ec == chfloat::errc::ok && rv.ptr == r.ptr);
+    }
+  }
+  test_parse_ok<double>("-3.25e2", -325.0, chfloat::chars_format::json);
+  test_parse_ok<float>("0.1", 0.1f, chfloat::chars_format::json);
+  {
+    float f = 0;
+    const std::string_view s = "1e39";
+    const auto r = chfloat::from_chars_json(s.data(), s.data() + s.size(), f);
+    CHECK(r.ec == chfloat::errc::result_out_of_range && !r.integer);
+  }
+}
+
+static void test_from_chars_padded() {
+  // Padding full of digits, dots and exponent markers must never be read as part of a number.
+  const char* const inputs[] = {"0", "-1.5", "7.", ".25", "1e5", "1e", "2.5E-3", "123456789012345678901234567890",
+                                "0.000000000000000000000000000001e+30", "1.7976931348623157e308", "inf", "x", "", "-.e1"};
+  const char junk[] = "9.e9+1234567890e-.9999999999999999";
+  for (const char* in : inputs) {
+    const std::string_view sv = in;
+    std::string buf(sv);
+    buf.append(junk, chfloat::from_chars_padding);
+    const char* first = buf.data();
+    const char* last = first + sv.size();
+    double a = 0, b = 0;
+    const auto ra = chfloat::from_chars(first, last, a);
+    const auto rb = chfloat::from_chars_padded(first, last, b);
+    CHECK(ra.ec == rb.ec && ra.ptr == rb.ptr && equal_or_both_nan(a, b));
+    float fa = 0, fb = 0;
+    const auto rfa = chfloat::from_chars(first, last, fa, chfloat::chars_format::scientific);
+    const auto rfb = chfloat::from_chars_padded(first, last, fb, chfloat::chars_format::scientific);
+    CHECK(rfa.ec == rfb.ec && rfa.ptr == rfb.ptr && equal_or_both_nan(fa, fb));
+  }
+  std::string buf = "12.5";
+  buf.append(chfloat::from_chars_padding, '7');
+  double v = 0;
+  const auto r = chfloat::from_chars_padded(buf.data(), buf.data() + 4, v, chfloat::chars_format::fixed);
+  CHECK(r.ec == chfloat::errc::ok && r.ptr == buf.data() + 4 && v == 12.5);
+}
+
+#if CHFLOAT_HAS_CONSTEXPR_FROM_CHARS
+template <class T>
+constexpr T parse_constant(std::string_view s, chfloat::chars_format fmt = chfloat::chars_format::general) {
+  T v = T(0);
+  const chfloat::from_chars_result r = chfloat::from_chars(s.data(), s.data() + s.size(), v, fmt);
+  return (r.ec == chfloat::errc::ok && r.ptr == s.data() + s.size()) ? v : T(-12345);
+}
+
+template <class T>
+constexpr chfloat::errc constant_ec(std::string_view s) {
+  T v = T(0);
+  return chfloat::from_chars(s.data(), s.data() + s.size(), v).ec;
+}
+
+// A lookup table generated from decimal literals at compile time.
+constexpr std::string_view k_constant_literals[] = {
+    "0.5", "2.718281828459045235360287471352662497757", "1e23", "-6.02214076e23", "2.2250738585072011e-308",
+    "1.7976931348623157e308", "123456789012345678901234567890", "0.000000000000000000000000000001", "7e-10",
+};
+
+struct constant_table {
+  double d[9];
+  float f[9];
+};
+
+constexpr constant_table make_constant_table() {
+  // Values as from_chars leaves them, including the float overflows and underflows.
+  constant_table t{};
+  for (int i = 0; i < 9; ++i) {
+    const std::string_view s = k_constant_literals[i];
+    chfloat::from_chars(s.data(), s.data() + s.size(), t.d[i]);
+    chfloat::from_chars(s.data(), s.data() + s.size(), t.f[i]);
+  }
+  return t;
+}
+#endif
+
+static void test_constexpr_from_chars() {
+#if CHFLOAT_HAS_CONSTEXPR_FROM_CHARS
+  const auto hex = chfloat::chars_format::hex;
+  static_assert(parse_constant<double>("3.141592653589793") == 3.141592653589793);
+  static_assert(parse_constant<double>("-1.5e-3") == -1.5e-3);
+  static_assert(parse_constant<double>("1.25", chfloat::chars_format::fixed) == 1.25);
+  static_assert(parse_constant<float>("0.1") == 0.1f);
+  static_assert(parse_constant<float>("3.4028234663852886e38") == std::numeric_limits<float>::max());
+  // Eisel-Lemire, long mantissas, the exact big-decimal fallback and subnormals.
+  static_assert(parse_constant<double>("1.23456789012345678901234567890123456789") == 1.2345678901234568);
+  static_assert(parse_constant<double>("9007199254740993") == 9007199254740992.0);
+  static_assert(parse_constant<double>("9007199254740993.00000000000000000000000000001") == 9007199254740994.0);
+  static_assert(parse_constant<double>("4.9406564584124654e-324") == std::numeric_limits<double>::denorm_min());
+  static_assert(parse_constant<float>("1.0000000596046447753906250000000001") == 0x1.000002p0f);
+  static_assert(parse_constant<float>("1.0000000596046447753906249999999999") == 1.0f);
+  // Hex, specials and errors.
+  static_assert(parse_constant<double>("-0x1.8p1", hex) == -3.0);
+  static_assert(parse_constant<float>("0x1p-149", hex) == std::numeric_limits<float>::denorm_min());
+  static_assert(parse_constant<double>("-inf") == -std::numeric_limits<double>::infinity());
+  static_assert(parse_constant<double>("nan") != parse_constant<double>("nan"));
+  static_assert(constant_ec<double>("1e400") == chfloat::errc::result_out_of_range);
+  static_assert(constant_ec<float>("1e-50") == chfloat::errc::result_out_of_range);
+  static_assert(constant_ec<double>("x") == chfloat::errc::invalid_argument);
+  static_assert([] {
+    double v = 0;
+    const std::string_view s = "-12.5e1,";
+    const chfloat::from_chars_json_result r = chfloat::from_chars_json(s.data(), s.data() + s.size(), v);
+    return r.ec == chfloat::errc::ok && r.ptr == s.data() + 7 && v == -125.0 && !r.integer;
+  }());
+
+  // The compile-time results are the runtime ones.
+  constexpr constant_table table = make_constant_table();
+  for (int i = 0; i < 9; ++i) {
+    const std::string_view s = k_constant_literals[i];
+    double d = 0;
+    float f = 0;
+    chfloat::from_chars(s.data(), s.data() + s.size(), d);
+    chfloat::from_chars(s.data(), s.data() + s.size(), f);
+    CHECK(bitcast_u64(table.d[i]) == bitcast_u64(d));
+    CHECK(bitcast_u64(table.f[i]) == bitcast_u64(f));
+  }
+#endif
+}
+
+// Parses s as CharT code units and as char: ptr offset, ec and value bits must agree. The unit
+// at `poison` (when < s.size()) is replaced by `unit` in the wide copy and by '#' in the char one.
+template <class T, class CharT>
+static void check_units_like_chars(const std::string& s, chfloat::chars_format fmt, size_t poison, CharT unit) {
+  std::string narrow = s;
+  std::basic_string<CharT> wide(s.begin(), s.end());
+  if (poison < s.size()) {
+    narrow[poison] = '#';
+    wide[poison] = unit;
+  }
+  T want = T(-7);
+  T got = T(-7);
+  const chfloat::from_chars_result r = chfloat::from_chars(narrow.data(), narrow.data() + narrow.size(), want, fmt);
+  const chfloat::basic_from_chars_result<CharT> w =
+      chfloat::from_chars(wide.data(), wide.data() + wide.size(), got, fmt);
+  CHECK(w.ec == r.ec);
+  CHECK(w.ptr - wide.data() == r.ptr - narrow.data());
+  CHECK(bitcast_u64(got) == bitcast_u64(want));
+}
+
+template <class CharT>
+static void check_units_all(const std::vector<CharT>& poison_units) {
+  using fmt = chfloat::chars_format;
+  struct wcase {
+    std::string s;
+    fmt f;
+  };
+  const wcase cases[] = {
+      {"0", fmt::general},
+      {"-1.5", fmt::general},
+      {"+.5e-3", fmt::general},
+      {"1E-10x", fmt::general},
+      {"-Infinity", fmt::general},
+      {"nan", fmt::general},
+      {"1e400", fmt::general},
+      {"1.5e", fmt::general},
+      {"123456789.123456789e+5,", fmt::general},
+      {"0.000000000000000000001234567", fmt::general},
+      {"12345678901234567890123e-3", fmt::general},
+      {"9007199254740993.00000000000000000000000000001", fmt::general},
+      {"1.0000000596046447753906250000000001", fmt::general},
+      {"1.25e3", fmt::fixed},
+      {"-2E-2", fmt::scientific},
+      {"0x1.8p1", fmt::hex},
+      {"-0X1.fffffffffffffp1023", fmt::hex},
+      {"a.8p-3", fmt::hex},
+      {"-0.5e+2", fmt::json},
+      {"01", fmt::json},
+      {"12345678901234567890.5]", fmt::json},
+  };
+  for (const wcase& c : cases) {
+    for (size_t i = 0; i <= c.s.size(); ++i) {
+      for (const CharT u : poison_units) {
+        check_units_like_chars<double>(c.s, c.f, i, u);
+        check_units_like_chars<float>(c.s, c.f, i, u);
+      }
+    }
+  }
+}
+
+static void test_wide_from_chars() {
+  {
+    const std::u16string s = u"-12.5e1,";
+    double d = 0;
+    const chfloat::basic_from_chars_result<char16_t> r = chfloat::from_chars(s.data(), s.data() + s.size(), d);
+    CHECK(r.ec == chfloat::errc::ok && r.ptr == s.data() + 7 && d == -125.0);
+  }
+  {
+    // FULLWIDTH DIGIT ONE is not a digit.
+    const std::wstring s = L"１";
+    float f = 0;
+    CHECK(chfloat::from_chars(s.data(), s.data() + s.size(), f).ec == chfloat::errc::invalid_argument);
+  }
+
+  // Units whose low byte (or, for SSE2's signed narrowing, whose saturated value) could pass for
+  // '0'..'9', '.', 'e' or 'x' must still end the number wherever they appear.
+  const std::vector<char16_t> units16 = {0x0131, 0x012e, 0x0165, 0x0178, 0xff30, 0x8039, 0xd835};
+  const std::vector<char32_t> units32 = {0x00010031, 0x0000012e, 0x80000030, 0xffffff65, 0x7fff0039};
+  check_units_all<char16_t>(units16);
+  check_units_all<char32_t>(units32);
+  std::vector<wchar_t> unitsw;
+  if (sizeof(wchar_t) == 2) {
+    for (const char16_t u : units16) unitsw.push_back(static_cast<wchar_t>(u));
+  } else {
+    for (const char32_t u : units32) unitsw.push_back(static_cast<wchar_t>(u));
+  }
+  check_units_all<wchar_t>(unitsw);
+
+#if CHFLOAT_HAS_CONSTEXPR_FROM_CHARS
+  static_assert([] {
+    double v = 0;
+    const std::u16string_view s = u"6.02214076e23";
+    const chfloat::basic_from_chars_result<char16_t> r = chfloat::from_chars(s.data(), s.data() + s.size(), v);
+    return r.ec == chfloat::errc::ok && r.ptr == s.data() + s.size() && v == 6.02214076e23;
+  }());
+#endif
+}
+
+static void test_validate() {
+  struct vcase {
+    const char* s;
+    chfloat::chars_format fmt;
+    size_t end; // 0: invalid_argument
+  };
+  const std::string long_digits = "0." + std::string(60, '1') + "e+05x";
+  const vcase cases[] = {
+      {"123", chfloat::chars_format::general, 3},
+      {"-1.5e-3,", chfloat::chars_format::general, 7},
+      {"+.5", chfloat::chars_format::general, 3},
+      {"7.", chfloat::chars_format::general, 2},
+      {"1e", chfloat::chars_format::general, 1},
+      {"1e+", chfloat::chars_format::general, 1},
+      {"1e400", chfloat::chars_format::general, 5}, // no conversion: not out of range
+      {"-infinity", chfloat::chars_format::general, 9},
+      {"NaN", chfloat::chars_format::general, 3},
+      {"infx", chfloat::chars_format::general, 3},
+      {".", chfloat::chars_format::general, 0},
+      {"-", chfloat::chars_format::general, 0},
+      {"e5", chfloat::chars_format::general, 0},
+      {"", chfloat::chars_format::general, 0},
+      {"1.5e3", chfloat::chars_format::fixed, 3},
+      {"1.5", chfloat::chars_format::scientific, 0},
+      {"1.5E3", chfloat::chars_format::scientific, 5},
+      {"0x1.8p1", chfloat::chars_format::hex, 7},
+      {"0x", chfloat::chars_format::hex, 1},
+      {"p3", chfloat::chars_format::hex, 0},
+  };
+  for (const vcase& c : cases) {
+    const std::string_view s = c.s;
+    const auto r = chfloat::validate(s.data(), s.data() + s.size(), c.fmt);
+    if (c.end == 0) {
+      CHECK(r.ec == chfloat::errc::invalid_argument && r.ptr == s.data());
+    } else {
+      CHECK(r.ec == chfloat::errc::ok && r.ptr == s.data() + c.end);
+    }
+  }
+  const auto r = chfloat::validate(long_digits.data(), long_digits.data() + long_digits.size());
+  CHECK(r.ec == chfloat::errc::ok && r.ptr == long_digits.data() + long_digits.size() - 1);
+}
+
 static void test_ws_variant() {
   float out = 0;
   const char* first = "  \t\n-12.5";
@@ -183,6 +840,439 @@ static void test_int_basic() {
   }
 }
 
+static void test_int_decimal_fast_path() {
+  auto parse_ull = [](std::string_view s, unsigned long long& v) {
+    return chfloat::from_chars(s.data(), s.data() + s.size(), v);
+  };
+  unsigned long long u = 0;
+  CHECK(parse_ull("18446744073709551615", u).ec == chfloat::errc::ok && u == 18446744073709551615ULL);
+  CHECK(parse_ull("000000000000000000000018446744073709551615", u).ec == chfloat::errc::ok &&
+        u == 18446744073709551615ULL);
+  CHECK(parse_ull("18446744073709551616", u).ec == chfloat::errc::result_out_of_range);
+  CHECK(parse_ull("99999999999999999999", u).ec == chfloat::errc::result_out_of_range);
+  CHECK(parse_ull("1234567890123456789", u).ec == chfloat::errc::ok && u == 1234567890123456789ULL);
+  CHECK(parse_ull("0", u).ec == chfloat::errc::ok && u == 0);
+  {
+    // Overflow consumes the whole digit run; a short run stops at the first non-digit.
+    const std::string_view s = "123456789012345678901234,5";
+    auto r = parse_ull(s, u);
+    CHECK(r.ec == chfloat::errc::result_out_of_range && r.ptr == s.data() + 24);
+    const std::string_view t = "12345678x";
+    r = parse_ull(t, u);
+    CHECK(r.ec == chfloat::errc::ok && r.ptr == t.data() + 8 && u == 12345678ULL);
+  }
+
+  long long ll = 0;
+  const std::string_view ll_min = "-9223372036854775808";
+  CHECK(chfloat::from_chars(ll_min.data(), ll_min.data() + ll_min.size(), ll).ec == chfloat::errc::ok &&
+        ll == std::numeric_limits<long long>::min());
+  const std::string_view ll_over = "9223372036854775808";
+  CHECK(chfloat::from_chars(ll_over.data(), ll_over.data() + ll_over.size(), ll).ec ==
+        chfloat::errc::result_out_of_range);
+
+  int i = 0;
+  const std::string_view i_min = "-2147483648";
+  CHECK(chfloat::from_chars(i_min.data(), i_min.data() + i_min.size(), i).ec == chfloat::errc::ok &&
+        i == std::numeric_limits<int>::min());
+  const std::string_view i_over = "-2147483649";
+  CHECK(chfloat::from_chars(i_over.data(), i_over.data() + i_over.size(), i).ec == chfloat::errc::result_out_of_range);
+  const std::string_view sign_only = "-";
+  auto r = chfloat::from_chars(sign_only.data(), sign_only.data() + 1, i);
+  CHECK(r.ec == chfloat::errc::invalid_argument && r.ptr == sign_only.data());
+
+  unsigned v = 0;
+  const std::string_view u_max = "4294967295";
+  CHECK(chfloat::from_chars(u_max.data(), u_max.data() + u_max.size(), v).ec == chfloat::errc::ok && v == 4294967295u);
+  const std::string_view u_over = "4294967296";
+  CHECK(chfloat::from_chars(u_over.data(), u_over.data() + u_over.size(), v).ec == chfloat::errc::result_out_of_range);
+  const std::string_view u_neg = "-1";
+  CHECK(chfloat::from_chars(u_neg.data(), u_neg.data() + u_neg.size(), v).ec == chfloat::errc::invalid_argument);
+}
+
+static void test_int_compile_time_base() {
+  auto sv_end = [](std::string_view s) { return s.data() + s.size(); };
+  unsigned long long u = 0;
+  const std::string_view hex_max = "FFFFffffFFFFffff";
+  CHECK(chfloat::from_chars<16>(hex_max.data(), sv_end(hex_max), u).ec == chfloat::errc::ok && u == ~0ULL);
+  const std::string_view hex_over = "1ffffffffffffffff,";
+  auto r = chfloat::from_chars<16>(hex_over.data(), sv_end(hex_over), u);
+  CHECK(r.ec == chfloat::errc::result_out_of_range && r.ptr == hex_over.data() + 17);
+  const std::string_view oct_max = "1777777777777777777777";
+  CHECK(chfloat::from_chars<8>(oct_max.data(), sv_end(oct_max), u).ec == chfloat::errc::ok && u == ~0ULL);
+  const std::string_view bin = "1011z";
+  r = chfloat::from_chars<2>(bin.data(), sv_end(bin), u);
+  CHECK(r.ec == chfloat::errc::ok && u == 11 && r.ptr == bin.data() + 4);
+
+  unsigned v = 0;
+  const std::string_view hex32_over = "100000000";
+  CHECK(chfloat::from_chars<16>(hex32_over.data(), sv_end(hex32_over), v).ec == chfloat::errc::result_out_of_range);
+  const std::string_view b36 = "1z141z3";
+  CHECK(chfloat::from_chars<36>(b36.data(), sv_end(b36), v).ec == chfloat::errc::ok && v == 4294967295u);
+
+  int i = 0;
+  const std::string_view neg_hex = "-80000000";
+  CHECK(chfloat::from_chars<16>(neg_hex.data(), sv_end(neg_hex), i).ec == chfloat::errc::ok &&
+        i == std::numeric_limits<int>::min());
+  CHECK(chfloat::from_chars(neg_hex.data(), sv_end(neg_hex), i, 16).ec == chfloat::errc::ok &&
+        i == std::numeric_limits<int>::min());
+  const std::string_view not_hex = "-g";
+  r = chfloat::from_chars<16>(not_hex.data(), sv_end(not_hex), i);
+  CHECK(r.ec == chfloat::errc::invalid_argument && r.ptr == not_hex.data());
+
+  // Runtime bases outside the specialized set keep working.
+  long long ll = 0;
+  const std::string_view b3 = "-2212";
+  CHECK(chfloat::from_chars(b3.data(), sv_end(b3), ll, 3).ec == chfloat::errc::ok && ll == -77);
+  CHECK(chfloat::from_chars(b3.data(), sv_end(b3), ll, 37).ec == chfloat::errc::invalid_argument);
+}
+
+static void test_from_chars_many() {
+  {
+    const std::string_view s = "1.5,-2,3e2,nan,0.25,";
+    double out[8] = {};
+    auto r = chfloat::from_chars_many(s.data(), s.data() + s.size(), ',', out, 8);
+    CHECK(r.ec == chfloat::errc::ok);
+    CHECK(r.count == 5);
+    CHECK(r.ptr == s.data() + s.size());
+    CHECK(out[0] == 1.5 && out[1] == -2.0 && out[2] == 300.0 && is_nan(out[3]) && out[4] == 0.25);
+  }
+  {
+    // cap reached: stop at the start of the next token and resume from there.
+    const std::string_view s = "1\n2\n3";
+    float out[2] = {};
+    auto r = chfloat::from_chars_many(s.data(), s.data() + s.size(), '\n', out, 2);
+    CHECK(r.ec == chfloat::errc::ok);
+    CHECK(r.count == 2);
+    CHECK(r.ptr == s.data() + 4);
+    r = chfloat::from_chars_many(r.ptr, s.data() + s.size(), '\n', out, 2);
+    CHECK(r.ec == chfloat::errc::ok && r.count == 1 && out[0] == 3.0f);
+  }
+  {
+    const std::string_view s = "1;2x;3";
+    double out[4] = {};
+    auto r = chfloat::from_chars_many(s.data(), s.data() + s.size(), ';', out, 4);
+    CHECK(r.ec == chfloat::errc::invalid_argument);
+    CHECK(r.count == 1);
+    CHECK(r.ptr == s.data() + 2);
+  }
+  {
+    const std::string_view s = "1,,2";
+    double out[4] = {};
+    auto r = chfloat::from_chars_many(s.data(), s.data() + s.size(), ',', out, 4);
+    CHECK(r.ec == chfloat::errc::invalid_argument);
+    CHECK(r.count == 1);
+    CHECK(r.ptr == s.data() + 2);
+  }
+}
+
+static void test_from_chars_many_parallel() {
+  // Large enough to be split into several slices; every variant must match the serial call.
+  std::string s;
+  for (int i = 0; i < 100000; ++i) s += std::to_string(i * 7919 % 100003) + "." + std::to_string(i % 97) + ",";
+  const char* first = s.data();
+  const char* last = s.data() + s.size();
+  std::vector<double> serial(100000), par(100000);
+  const auto rs = chfloat::from_chars_many(first, last, ',', serial.data(), serial.size());
+  const auto rp = chfloat::from_chars_many_parallel(first, last, ',', par.data(), par.size(), 4);
+  CHECK(rs.ec == chfloat::errc::ok && rs.count == 100000 && rs.ptr == last);
+  CHECK(rp.ec == rs.ec && rp.count == rs.count && rp.ptr == rs.ptr);
+  CHECK(par == serial);
+
+  {
+    // cap reached inside a slice: stop at the same token as from_chars_many.
+    const auto r1 = chfloat::from_chars_many(first, last, ',', serial.data(), 54321);
+    const auto r2 = chfloat::from_chars_many_parallel(first, last, ',', par.data(), 54321, 4);
+    CHECK(r2.ec == r1.ec && r2.count == r1.count && r2.ptr == r1.ptr);
+  }
+  {
+    // Error in a later slice, run through a caller-provided executor.
+    std::string bad = s;
+    bad[bad.size() * 3 / 4] = 'x';
+    unsigned calls = 0;
+    auto inline_exec = [&calls](unsigned n, auto&& task) {
+      ++calls;
+      for (unsigned i = 0; i < n; ++i) task(i);
+    };
+    const auto r1 = chfloat::from_chars_many(bad.data(), bad.data() + bad.size(), ',', serial.data(), serial.size());
+    const auto r2 = chfloat::from_chars_many_parallel(bad.data(), bad.data() + bad.size(), ',', par.data(), par.size(),
+                                                      8, inline_exec);
+    CHECK(r1.ec == chfloat::errc::invalid_argument);
+    CHECK(r2.ec == r1.ec && r2.count == r1.count && r2.ptr == r1.ptr);
+    CHECK(calls == 2);
+  }
+}
+
+static void test_runtime_dispatch() {
+#if CHFLOAT_DISPATCH_X86
+  // The AVX2/BMI2 kernels and the portable ones must agree bit for bit, including digit runs
+  // that end at every offset of a 32-byte block.
+  std::string s;
+  for (int len = 1; len <= 100; ++len) {
+    for (int dot = 0; dot <= len; dot += 7) {
+      std::string t;
+      for (int i = 0; i < len; ++i) t += static_cast<char>('1' + (i * 7 + len) % 9);
+      t.insert(static_cast<size_t>(dot), ".");
+      s += t + ",-" + t + "e-" + std::to_string(len % 50) + ",";
+    }
+  }
+  s += "9007199254740993,1.000000059604644775390625,4.9406564584124654e-324,nan,-inf,";
+  const char* first = s.data();
+  const char* last = s.data() + s.size();
+
+  // The AVX2 kernel is called directly (only on hosts that can run it) rather than through
+  // the dispatcher, so the comparison never touches host_cpu.
+  if (chfloat::detail::host_cpu.avx2_bmi2) {
+    using chfloat::detail::fp_single_sep;
+    std::vector<double> d_fast(4000), d_port(4000);
+    std::vector<float> f_fast(4000), f_port(4000);
+    const auto rd_fast = chfloat::detail::parse_fp_many_avx2(first, last, ',', d_fast.data(), d_fast.size());
+    const auto rf_fast = chfloat::detail::parse_fp_many_avx2(first, last, ',', f_fast.data(), f_fast.size());
+    const auto rd_port =
+        chfloat::detail::parse_fp_many(first, last, fp_single_sep{','}, d_port.data(), d_port.size());
+    const auto rf_port =
+        chfloat::detail::parse_fp_many(first, last, fp_single_sep{','}, f_port.data(), f_port.size());
+
+    CHECK(rd_port.ec == 0 && rd_port.ptr == last);
+    CHECK(rd_fast.ec == rd_port.ec && rd_fast.count == rd_port.count && rd_fast.ptr == rd_port.ptr);
+    CHECK(rf_fast.ec == rf_port.ec && rf_fast.count == rf_port.count && rf_fast.ptr == rf_port.ptr);
+    CHECK(std::memcmp(d_fast.data(), d_port.data(), rd_port.count * sizeof(double)) == 0);
+    CHECK(std::memcmp(f_fast.data(), f_port.data(), rf_port.count * sizeof(float)) == 0);
+  }
+
+  // Single values with long runs reach digit_run_end directly.
+  const std::string long_run = "1." + std::string(70, '3') + "x";
+  double v = 0;
+  const auto r = chfloat::from_chars(long_run.data(), long_run.data() + long_run.size(), v);
+  CHECK(r.ec == chfloat::errc::ok && r.ptr == long_run.data() + long_run.size() - 1 && v == 1.3333333333333333);
+#endif
+}
+
+static std::FILE* make_temp_file(std::string_view content) {
+  std::FILE* f = std::tmpfile();
+  if (f == nullptr) return nullptr;
+  std::fwrite(content.data(), 1, content.size(), f);
+  std::rewind(f);
+  return f;
+}
+
+static void test_number_stream() {
+  {
+    // Records split across tiny chunks, one longer than a chunk, CRLF and a trailing newline.
+    std::string content;
+    std::vector<double> expected;
+    for (int i = 0; i < 200; ++i) {
+      content += std::to_string(i) + ".25" + ((i % 3 == 0) ? "\r\n" : ",");
+      expected.push_back(i + 0.25);
+    }
+    content += "3.14159265358979323846264338327950288\n";
+    expected.push_back(3.14159265358979323846264338327950288);
+
+    std::FILE* f = make_temp_file(content);
+    CHECK(f != nullptr);
+    if (f == nullptr) return;
+    chfloat::stream_options opt;
+    opt.chunk_size = 16;
+    chfloat::double_stream s(f, opt);
+    std::vector<double> got;
+    while (s.next() == chfloat::errc::ok && s.size() != 0) got.insert(got.end(), s.data(), s.data() + s.size());
+    CHECK(got == expected);
+    std::fclose(f);
+  }
+  {
+    // Error offset is the file offset of the bad record; values before it are kept.
+    std::FILE* f = make_temp_file("1\n2\n 3x\n4\n");
+    CHECK(f != nullptr);
+    if (f == nullptr) return;
+    chfloat::float_stream s(f, chfloat::stream_options{"\n", 4});
+    std::vector<float> got;
+    chfloat::errc ec = chfloat::errc::ok;
+    while ((ec = s.next()) == chfloat::errc::ok && s.size() != 0) got.insert(got.end(), s.data(), s.data() + s.size());
+    got.insert(got.end(), s.data(), s.data() + s.size());
+    CHECK(ec == chfloat::errc::invalid_argument);
+    CHECK(s.error_offset() == 4);
+    CHECK(got.size() == 2 && got[0] == 1.0f && got[1] == 2.0f);
+    CHECK(s.next() == chfloat::errc::invalid_argument);
+    std::fclose(f);
+  }
+  {
+    // Blank lines (also "\r\n" and whitespace-only ones) are skipped anywhere, as in csv.h; an
+    // empty record between other separators is still an error.
+    std::FILE* f = make_temp_file("\n1\n\n \t\n2\r\n\r\n3\n\n");
+    CHECK(f != nullptr);
+    if (f == nullptr) return;
+    chfloat::double_stream s(f, chfloat::stream_options{",\n", 3});
+    std::vector<double> got;
+    while (s.next() == chfloat::errc::ok && s.size() != 0) got.insert(got.end(), s.data(), s.data() + s.size());
+    CHECK((got == std::vector<double>{1, 2, 3}));
+    CHECK(s.next() == chfloat::errc::ok && s.size() == 0);
+    std::fclose(f);
+
+    f = make_temp_file("1,,2\n");
+    CHECK(f != nullptr);
+    if (f == nullptr) return;
+    chfloat::double_stream t(f);
+    CHECK(t.next() == chfloat::errc::invalid_argument);
+    CHECK(t.error_offset() == 2);
+    std::fclose(f);
+  }
+  {
+    // Trailing and mid-file separator runs give the same values, error and offset whichever
+    // chunk boundary they straddle.
+    const char* inputs[] = {"1.5\n2\n22\n\n", "1\n\n2\n", "\n", ",", "nan\n,\n", " 3 ,\n \n", "\n1", "1,,2\n", "1\n\n,2\n"};
+    for (const char* in : inputs) {
+      std::vector<double> want;
+      chfloat::errc want_ec = chfloat::errc::ok;
+      unsigned long long want_offset = 0;
+      const chfloat::detail::usize chunks[] = {chfloat::detail::usize(1) << 20, 1, 2, 3, 7};
+      for (const chfloat::detail::usize chunk : chunks) {
+        std::FILE* f = make_temp_file(in);
+        CHECK(f != nullptr);
+        if (f == nullptr) return;
+        chfloat::stream_options opt;
+        opt.chunk_size = chunk;
+        chfloat::double_stream s(f, opt);
+        std::vector<double> got;
+        chfloat::errc ec = chfloat::errc::ok;
+        while ((ec = s.next()) == chfloat::errc::ok && s.size() != 0) got.insert(got.end(), s.data(), s.data() + s.size());
+        got.insert(got.end(), s.data(), s.data() + s.size());
+        std::fclose(f);
+        if (chunk == chunks[0]) {
+          want = got;
+          want_ec = ec;
+          want_offset = s.error_offset();
+          continue;
+        }
+        CHECK(ec == want_ec);
+        CHECK(s.error_offset() == want_offset);
+        CHECK(got.size() == want.size());
+        for (size_t i = 0; i < got.size() && i < want.size(); ++i) CHECK(bitcast_u64(got[i]) == bitcast_u64(want[i]));
+      }
+    }
+  }
+  {
+    chfloat::double_stream s("/nonexistent/chfloat/stream/input.csv");
+    CHECK(!s.is_open());
+    CHECK(s.next() == chfloat::errc::invalid_argument);
+  }
+}
+
+static void test_csv_columns() {
+  using chfloat::column_type;
+  const column_type schema[] = {column_type::i64, column_type::skip, column_type::f64, column_type::f32};
+  {
+    // Header, quoted fields (numeric and text with "" and a delimiter), blanks, CRLF, blank
+    // lines and a last row without a newline.
+    const std::string text =
+        "id,name,price,weight\n"
+        "1,apple,0.5,1.25\r\n"
+        "\n"
+        "-2,\"pear, \"\"green\"\"\",\"1e3\", 2.5 \n"
+        "3,,-0.125,3";
+    std::vector<chfloat::csv_column> cols;
+    chfloat::csv_options opt;
+    opt.header = true;
+    const chfloat::from_chars_many_result r =
+        chfloat::parse_csv(text.data(), text.data() + text.size(), schema, 4, cols, opt);
+    CHECK(r.ec == chfloat::errc::ok && r.ptr == text.data() + text.size() && r.count == 3);
+    CHECK(cols.size() == 4 && cols[1].f64.empty() && cols[1].i64.empty());
+    CHECK((cols[0].i64 == std::vector<long long>{1, -2, 3}));
+    CHECK((cols[2].f64 == std::vector<double>{0.5, 1e3, -0.125}));
+    CHECK((cols[3].f32 == std::vector<float>{1.25f, 2.5f, 3.0f}));
+  }
+  {
+    // Errors point at the offending field; the rows before it are kept.
+    const column_type two[] = {column_type::f64, column_type::f64};
+    struct bad_case {
+      const char* text;
+      std::size_t offset;
+      std::size_t rows;
+      chfloat::errc ec;
+    };
+    const bad_case cases[] = {
+        {"1,2\n3,x\n", 6, 1, chfloat::errc::invalid_argument},   // not a number
+        {"1,2\n3,\n", 6, 1, chfloat::errc::invalid_argument},    // empty numeric field
+        {"1,2\n3\n", 4, 1, chfloat::errc::invalid_argument},     // too few fields
+        {"1,2,3\n", 2, 0, chfloat::errc::invalid_argument},      // too many fields
+        {"1,2x\n", 2, 0, chfloat::errc::invalid_argument},       // trailing garbage
+        {"1,\"2\n", 2, 0, chfloat::errc::invalid_argument},      // unterminated quote
+    };
+    for (const bad_case& c : cases) {
+      std::vector<chfloat::csv_column> cols;
+      const char* first = c.text;
+      const chfloat::from_chars_many_result r = chfloat::parse_csv(first, first + std::strlen(first), two, 2, cols);
+      CHECK(r.ec == c.ec && r.ptr == first + c.offset && r.count == c.rows);
+      CHECK(cols[0].f64.size() == c.rows && cols[1].f64.size() == c.rows);
+    }
+    const column_type one[] = {column_type::i64};
+    std::vector<chfloat::csv_column> cols;
+    const std::string big = "1\n99999999999999999999\n";
+    const chfloat::from_chars_many_result r = chfloat::parse_csv(big.data(), big.data() + big.size(), one, 1, cols);
+    CHECK(r.ec == chfloat::errc::result_out_of_range && r.ptr == big.data() + 2 && r.count == 1);
+  }
+  {
+    // The file reader agrees with the in-memory parser for every chunk size, including
+    // chunks shorter than the header and than a row.
+    std::string text = "a,b,c,d\n";
+    for (int i = 0; i < 300; ++i) {
+      text += std::to_string(i * 7 - 1000) + "," + ((i % 5 == 0) ? "\"x,\"\"y\"\"\"" : "z") + "," +
+              std::to_string(i) + ".5e-1," + ((i % 4 == 0) ? "\"0.75\"" : std::to_string(i)) +
+              ((i % 3 == 0) ? "\r\n" : "\n");
+    }
+    chfloat::csv_options opt;
+    opt.header = true;
+    std::vector<chfloat::csv_column> expected;
+    const chfloat::from_chars_many_result r =
+        chfloat::parse_csv(text.data(), text.data() + text.size(), schema, 4, expected, opt);
+    CHECK(r.ec == chfloat::errc::ok && r.count == 300);
+
+    for (std::size_t chunk : {1, 3, 16, 100, 1 << 16}) {
+      std::FILE* f = make_temp_file(text);
+      CHECK(f != nullptr);
+      if (f == nullptr) return;
+      opt.chunk_size = chunk;
+      chfloat::csv_reader reader(f, schema, 4, opt);
+      std::vector<long long> ids;
+      std::vector<double> prices;
+      std::vector<float> weights;
+      while (reader.next() == chfloat::errc::ok && reader.rows() != 0) {
+        const std::vector<chfloat::csv_column>& c = reader.columns();
+        CHECK(c[0].i64.size() == reader.rows() && c[2].f64.size() == reader.rows());
+        ids.insert(ids.end(), c[0].i64.begin(), c[0].i64.end());
+        prices.insert(prices.end(), c[2].f64.begin(), c[2].f64.end());
+        weights.insert(weights.end(), c[3].f32.begin(), c[3].f32.end());
+      }
+      CHECK(ids == expected[0].i64 && prices == expected[2].f64 && weights == expected[3].f32);
+      std::fclose(f);
+    }
+  }
+  {
+    // Reader error offset is the file offset of the bad field.
+    const column_type one[] = {column_type::f32};
+    std::FILE* f = make_temp_file("1\n2\n3x\n4\n");
+    CHECK(f != nullptr);
+    if (f == nullptr) return;
+    chfloat::csv_options opt;
+    opt.chunk_size = 3;
+    chfloat::csv_reader reader(f, one, 1, opt);
+    std::vector<float> got;
+    chfloat::errc ec = chfloat::errc::ok;
+    while ((ec = reader.next()) == chfloat::errc::ok && reader.rows() != 0) {
+      got.insert(got.end(), reader.columns()[0].f32.begin(), reader.columns()[0].f32.end());
+    }
+    got.insert(got.end(), reader.columns()[0].f32.begin(), reader.columns()[0].f32.end());
+    CHECK(ec == chfloat::errc::invalid_argument);
+    CHECK(reader.error_offset() == 4);
+    CHECK((got == std::vector<float>{1.0f, 2.0f}));
+    CHECK(reader.next() == chfloat::errc::invalid_argument);
+    std::fclose(f);
+  }
+  {
+    const column_type one[] = {column_type::f64};
+    chfloat::csv_reader reader("/nonexistent/chfloat/csv/input.csv", one, 1);
+    CHECK(!reader.is_open());
+    CHECK(reader.next() == chfloat::errc::invalid_argument);
+  }
+}
 
 static void test_parse_digit() {
   unsigned d = 999;
@@ -195,10 +1285,30 @@ static void test_parse_digit() {
 
 int main() {
   test_float_double_basic();
+  test_float_long_digit_runs();
+  test_float_correct_rounding();
+  test_float_hex();
+  test_pow5_entry();
+  test_float_formats();
+  test_from_chars_scaled();
+  test_decimal_decomposition();
+  test_to_chars_shortest();
   test_float_specials_if_supported();
   test_float_errors();
+  test_from_chars_json();
+  test_from_chars_padded();
+  test_constexpr_from_chars();
+  test_wide_from_chars();
+  test_validate();
   test_ws_variant();
   test_int_basic();
+  test_int_decimal_fast_path();
+  test_int_compile_time_base();
+  test_from_chars_many();
+  test_from_chars_many_parallel();
+  test_runtime_dispatch();
+  test_number_stream();
+  test_csv_columns();
   test_parse_digit();
   return g_failures == 0 ? 0 : 1;
 }